@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// A tiny self-contained benchmark harness, so that the benchmarks do not need
+// anything outside of the tree.
+
+namespace bench {
+
+// Incremented by every global operator new (see bench_alloc.cpp)
+extern std::size_t allocations;
+
+// Keep the compiler from throwing away a result we never look at
+template <class T> void do_not_optimize(T const &val) {
+  asm volatile("" : : "g"(&val) : "memory");
+}
+
+struct Result {
+  double ns_per_call;
+  double ns_per_token;
+  double allocs_per_call;
+};
+
+// Time f, which parses a command line of tokens arguments (not counting the
+// program name). Enough iterations are run to cover roughly the same number of
+// tokens whatever the size of the command line.
+template <class F> Result run(std::size_t tokens, F &&f) {
+  // Warm up (and build any per-type schema) before we measure anything
+  f();
+  std::size_t const iterations =
+      std::max<std::size_t>(10, 4'000'000 / std::max<std::size_t>(tokens, 1));
+  auto const start_allocations = allocations;
+  auto const start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; i++) {
+    f();
+  }
+  std::chrono::duration<double, std::nano> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  auto const allocs = static_cast<double>(allocations - start_allocations);
+  return {
+      elapsed.count() / iterations,
+      elapsed.count() / (iterations * std::max<std::size_t>(tokens, 1)),
+      allocs / iterations,
+  };
+}
+
+inline void print_header() {
+  printf("%-40s %8s %12s %10s %12s\n", "benchmark", "tokens", "ns/call",
+         "ns/token", "allocs/call");
+}
+
+inline void report(const char *name, std::size_t tokens, Result const &res) {
+  printf("%-40s %8zu %12.1f %10.2f %12.2f\n", name, tokens, res.ns_per_call,
+         res.ns_per_token, res.allocs_per_call);
+}
+
+// Owns a command line and hands out an argv for it
+struct Args {
+  std::vector<std::string> storage;
+  std::vector<const char *> argv;
+
+  explicit Args(std::vector<std::string> args) : storage(std::move(args)) {
+    storage.insert(storage.begin(), "bench");
+    for (auto const &arg : storage) {
+      argv.push_back(arg.c_str());
+    }
+  }
+  int argc() const { return static_cast<int>(argv.size()); }
+  const char **data() { return argv.data(); }
+  // The number of arguments, not counting the program name
+  std::size_t tokens() const { return argv.size() - 1; }
+};
+
+} // namespace bench
@@ -0,0 +1,19 @@
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Count every allocation the benchmarks make, so that we can report
+// allocations per call alongside the timings
+
+std::size_t bench::allocations = 0;
+
+void *operator new(std::size_t size) {
+  bench::allocations++;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
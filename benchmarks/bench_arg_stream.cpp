@@ -0,0 +1,63 @@
+#include "bench.hpp"
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Parses a million null delimited tokens, once streamed from a file descriptor
+// through a 64 KiB buffer, and once from the same file as a response file
+// (which is mapped whole).
+
+struct Job {
+  int a;
+  int b;
+};
+
+template <> struct MetaInfo<Job> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  constexpr static bool response_files = true;
+};
+
+int main() {
+  constexpr std::size_t repeats = 250'000;
+  constexpr std::size_t tokens = repeats * 4;
+
+  std::string contents;
+  for (std::size_t i = 0; i < repeats; i++) {
+    contents.append("--a\0" "1\0" "--b\0" "2\0", 12);
+  }
+  char path[] = "/tmp/clapp_bench_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0 || write(fd, contents.data(), contents.size()) !=
+                    static_cast<ssize_t>(contents.size())) {
+    perror("clapp_bench");
+    return 1;
+  }
+
+  bench::Args file_args({std::string("@") + path});
+  Parser<Job> const parser{};
+  std::array<char, 64 * 1024> buffer;
+
+  auto const streamed = bench::run(tokens, [&] {
+    lseek(fd, 0, SEEK_SET);
+    bench::do_not_optimize(parser.parse_stream(fd, buffer));
+  });
+  auto const from_file = bench::run(tokens, [&] {
+    MappedFiles files;
+    bench::do_not_optimize(
+        parser.parse(file_args.argc(), file_args.data(), files));
+  });
+  close(fd);
+  unlink(path);
+
+  bench::print_header();
+  bench::report("stream", tokens, streamed);
+  bench::report("@file", tokens, from_file);
+}
@@ -0,0 +1,69 @@
+#include "bench.hpp"
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+
+#include <array>
+#include <cstdio>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// The latency of one completion request (one TAB press) against a struct with
+// hundreds of flags. ns/token is per flag in the struct.
+
+struct Members200 {
+  int _0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15,
+      _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29,
+      _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43,
+      _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57,
+      _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71,
+      _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85,
+      _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99,
+      _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110,
+      _111, _112, _113, _114, _115, _116, _117, _118, _119, _120, _121,
+      _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132,
+      _133, _134, _135, _136, _137, _138, _139, _140, _141, _142, _143,
+      _144, _145, _146, _147, _148, _149, _150, _151, _152, _153, _154,
+      _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165,
+      _166, _167, _168, _169, _170, _171, _172, _173, _174, _175, _176,
+      _177, _178, _179, _180, _181, _182, _183, _184, _185, _186, _187,
+      _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198,
+      _199;
+};
+
+template <> struct MetaInfo<Members200> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  constexpr static std::string_view complete_arg = "--clapp-complete";
+};
+
+int main() {
+  bench::print_header();
+  // The candidates go to stdout, which we do not want to time the terminal for
+  fflush(stdout);
+  int const saved_stdout = dup(STDOUT_FILENO);
+  int const null = open("/dev/null", O_WRONLY);
+  dup2(null, STDOUT_FILENO);
+
+  std::array<bench::Result, 3> results{};
+  std::array const names{"complete/flags=200/all", "complete/flags=200/prefix",
+                         "complete/flags=200/unique"};
+  constexpr std::size_t flags = 200;
+  auto run = [](auto args) {
+    return bench::run(flags, [&] {
+      bench::do_not_optimize(ParseArgs<Members200>(args.size(), args.data()));
+    });
+  };
+  results[0] = run(std::array{"bench", "--clapp-complete", "-"});
+  results[1] = run(std::array{"bench", "--clapp-complete", "--_19"});
+  results[2] = run(std::array{"bench", "--clapp-complete", "--_199"});
+
+  dup2(saved_stdout, STDOUT_FILENO);
+  close(null);
+  close(saved_stdout);
+  for (std::size_t i = 0; i < results.size(); i++) {
+    bench::report(names[i], flags, results[i]);
+  }
+}
@@ -0,0 +1,57 @@
+#include "bench.hpp"
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+// Parses config files of thousands of keys, streamed straight out of the
+// mapped file.
+
+struct Members64 {
+  int _0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,
+      _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31,
+      _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46,
+      _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61,
+      _62, _63;
+};
+
+// Write a config file of keys "_i = i" lines (cycling through the members),
+// returning its path
+std::string write_config(std::size_t keys) {
+  std::string contents = "# generated\n";
+  for (std::size_t i = 0; i < keys; i++) {
+    auto const member = std::to_string(i % 64);
+    contents += "_" + member + " = " + member + "\n";
+  }
+  char path[] = "/tmp/clapp_bench_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0 || write(fd, contents.data(), contents.size()) !=
+                    static_cast<ssize_t>(contents.size())) {
+    perror("clapp_bench");
+    return {};
+  }
+  close(fd);
+  return path;
+}
+
+int main() {
+  Parser<Members64> const parser{};
+  bench::print_header();
+  for (std::size_t keys : {64, 1024, 4096, 16384}) {
+    auto const path = write_config(keys);
+    if (path.empty()) {
+      return 1;
+    }
+    auto const res = bench::run(keys, [&] {
+      MappedFiles files;
+      bench::do_not_optimize(parser.parse_config(path.c_str(), files));
+    });
+    unlink(path.c_str());
+    char name[64];
+    snprintf(name, sizeof(name), "config/members=64/keys=%zu", keys);
+    bench::report(name, keys, res);
+  }
+}
@@ -0,0 +1,127 @@
+#include "bench.hpp"
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+// Throughput and per-call latency of ParseArgs across struct sizes, command
+// line lengths, flag/positional mixes, renamed flags and the failure paths.
+
+struct Members1 {
+  int _0;
+};
+
+struct Members8 {
+  int _0, _1, _2, _3, _4, _5, _6, _7;
+};
+
+struct Members32 {
+  int _0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,
+      _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31;
+};
+
+struct Members64 {
+  int _0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,
+      _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31,
+      _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46,
+      _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61,
+      _62, _63;
+};
+
+// Half flags, half positionals
+struct Mixed8 {
+  int a, b, c, d, w, x, y, z;
+  Options __w{.positional = true};
+  Options __x{.positional = true};
+  Options __y{.positional = true};
+  Options __z{.positional = true};
+};
+
+// Every flag renamed to a short flag
+struct Renamed8 {
+  int a, b, c, d, e, f, g, h;
+  Options __a{.name = "-a"};
+  Options __b{.name = "-b"};
+  Options __c{.name = "-c"};
+  Options __d{.name = "-d"};
+  Options __e{.name = "-e"};
+  Options __f{.name = "-f"};
+  Options __g{.name = "-g"};
+  Options __h{.name = "-h"};
+};
+
+// Rejects arguments it does not know about
+struct Strict8 {
+  int _0, _1, _2, _3, _4, _5, _6, _7;
+};
+
+template <> struct MetaInfo<Strict8> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+};
+
+// "--_i i" pairs for the first members members, repeated until we have tokens
+// arguments
+std::vector<std::string> member_flags(int members, std::size_t tokens) {
+  std::vector<std::string> args;
+  for (int i = 0; args.size() < tokens; i = (i + 1) % members) {
+    args.push_back("--_" + std::to_string(i));
+    args.push_back(std::to_string(i));
+  }
+  return args;
+}
+
+template <class T> void bench_parse(const char *name, bench::Args args) {
+  auto const res = bench::run(args.tokens(), [&] {
+    bench::do_not_optimize(ParseArgs<T>(args.argc(), args.data()));
+  });
+  bench::report(name, args.tokens(), res);
+}
+
+int main() {
+  bench::print_header();
+
+  // Every member given once as a flag, as the struct grows
+  bench_parse<Members1>("flags/members=1", bench::Args(member_flags(1, 2)));
+  bench_parse<Members8>("flags/members=8", bench::Args(member_flags(8, 16)));
+  bench_parse<Members32>("flags/members=32",
+                         bench::Args(member_flags(32, 64)));
+  bench_parse<Members64>("flags/members=64",
+                         bench::Args(member_flags(64, 128)));
+
+  // Longer and longer command lines against the same struct
+  for (std::size_t tokens : {16, 128, 1024, 8192}) {
+    char name[64];
+    snprintf(name, sizeof(name), "flags/members=8/tokens=%zu", tokens);
+    bench_parse<Members8>(name, bench::Args(member_flags(8, tokens)));
+  }
+
+  // The same flags, with their values attached as --_i=i
+  std::vector<std::string> inline_flags;
+  auto const pairs = member_flags(8, 16);
+  for (std::size_t i = 0; i < pairs.size(); i += 2) {
+    inline_flags.push_back(pairs[i] + "=" + pairs[i + 1]);
+  }
+  bench_parse<Members8>("inline/members=8", bench::Args(inline_flags));
+
+  // Flags and positionals interleaved
+  bench_parse<Mixed8>("mixed/members=8",
+                      bench::Args({"--a", "1", "5", "--b", "2", "6", "--c", "3",
+                                   "7", "--d", "4", "8"}));
+
+  // Renamed flags
+  bench_parse<Renamed8>("renamed/members=8",
+                        bench::Args({"-a", "1", "-b", "2", "-c", "3", "-d", "4",
+                                     "-e", "5", "-f", "6", "-g", "7", "-h",
+                                     "8"}));
+
+  // Failure paths: everything parses until the last argument
+  auto unknown = member_flags(8, 16);
+  unknown.push_back("--unknown");
+  bench_parse<Strict8>("unknown-arg/members=8", bench::Args(unknown));
+  auto bad_value = member_flags(8, 16);
+  bad_value.back() = "not an int";
+  bench_parse<Members8>("parse-error/members=8", bench::Args(bad_value));
+}
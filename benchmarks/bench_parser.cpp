@@ -0,0 +1,32 @@
+#include "bench.hpp"
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+
+// Compares a reusable Parser<T> against calling ParseArgs<T> for every command
+// line, the way a service that parses many job submissions would.
+
+struct Job {
+  int a;
+  int b;
+  int c;
+  int d;
+  int input;
+  int output;
+  Options __input{.positional = true};
+  Options __output{.positional = true};
+};
+
+int main() {
+  bench::Args args({"--a", "1", "--b", "2", "--c", "3", "--d", "4", "10", "20"});
+  Parser<Job> const parser{};
+
+  auto const parse_args = bench::run(args.tokens(), [&] {
+    bench::do_not_optimize(ParseArgs<Job>(args.argc(), args.data()));
+  });
+  auto const reused = bench::run(args.tokens(), [&] {
+    bench::do_not_optimize(parser.parse(args.argc(), args.data()));
+  });
+  bench::print_header();
+  bench::report("ParseArgs<T>", args.tokens(), parse_args);
+  bench::report("Parser<T>::parse", args.tokens(), reused);
+}
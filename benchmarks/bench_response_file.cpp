@@ -0,0 +1,62 @@
+#include "bench.hpp"
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+// Parses a command line of a million tokens, once from a response file (which
+// is mapped and tokenized in place) and once straight from an argv.
+
+struct Job {
+  int a;
+  int b;
+};
+
+template <> struct MetaInfo<Job> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  constexpr static bool response_files = true;
+};
+
+int main() {
+  constexpr std::size_t repeats = 250'000;
+  constexpr std::size_t tokens = repeats * 4;
+
+  std::string contents;
+  std::vector<std::string> storage;
+  for (std::size_t i = 0; i < repeats; i++) {
+    contents += "--a 1\n--b 2\n";
+    storage.insert(storage.end(), {"--a", "1", "--b", "2"});
+  }
+  char path[] = "/tmp/clapp_bench_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0 || write(fd, contents.data(), contents.size()) !=
+                    static_cast<ssize_t>(contents.size())) {
+    perror("clapp_bench");
+    return 1;
+  }
+  close(fd);
+
+  bench::Args file_args({std::string("@") + path});
+  bench::Args argv_args(std::move(storage));
+  Parser<Job> const parser{};
+
+  auto const from_file = bench::run(tokens, [&] {
+    MappedFiles files;
+    bench::do_not_optimize(
+        parser.parse(file_args.argc(), file_args.data(), files));
+  });
+  auto const from_argv = bench::run(tokens, [&] {
+    bench::do_not_optimize(parser.parse(argv_args.argc(), argv_args.data()));
+  });
+  unlink(path);
+
+  bench::print_header();
+  bench::report("@file", tokens, from_file);
+  bench::report("argv", tokens, from_argv);
+}
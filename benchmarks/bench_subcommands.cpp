@@ -0,0 +1,77 @@
+#include "bench.hpp"
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+
+#include <array>
+#include <variant>
+
+// Picks one of 32 subcommands and parses its args, against parsing the same
+// args straight into the command's struct.
+
+#define COMMAND(N)                                                             \
+  struct Cmd##N {                                                              \
+    int a;                                                                     \
+    int b;                                                                     \
+  };                                                                           \
+  template <> struct MetaInfo<Cmd##N> {                                        \
+    constexpr static std::string_view OptionsPrefix = "__";                    \
+    constexpr static std::array help_args{"--help", "--h"};                    \
+    constexpr static bool extra_args_ok = true;                                \
+    constexpr static std::string_view command_name = "cmd" #N;                 \
+  };
+
+COMMAND(0)
+COMMAND(1)
+COMMAND(2)
+COMMAND(3)
+COMMAND(4)
+COMMAND(5)
+COMMAND(6)
+COMMAND(7)
+COMMAND(8)
+COMMAND(9)
+COMMAND(10)
+COMMAND(11)
+COMMAND(12)
+COMMAND(13)
+COMMAND(14)
+COMMAND(15)
+COMMAND(16)
+COMMAND(17)
+COMMAND(18)
+COMMAND(19)
+COMMAND(20)
+COMMAND(21)
+COMMAND(22)
+COMMAND(23)
+COMMAND(24)
+COMMAND(25)
+COMMAND(26)
+COMMAND(27)
+COMMAND(28)
+COMMAND(29)
+COMMAND(30)
+COMMAND(31)
+
+#undef COMMAND
+
+using Commands =
+    std::variant<Cmd0, Cmd1, Cmd2, Cmd3, Cmd4, Cmd5, Cmd6, Cmd7, Cmd8, Cmd9,
+                 Cmd10, Cmd11, Cmd12, Cmd13, Cmd14, Cmd15, Cmd16, Cmd17, Cmd18,
+                 Cmd19, Cmd20, Cmd21, Cmd22, Cmd23, Cmd24, Cmd25, Cmd26, Cmd27,
+                 Cmd28, Cmd29, Cmd30, Cmd31>;
+
+int main() {
+  bench::Args command({"cmd27", "--a", "1", "--b", "2"});
+  bench::Args direct({"--a", "1", "--b", "2"});
+
+  auto const subcommand = bench::run(command.tokens(), [&] {
+    bench::do_not_optimize(ParseArgs<Commands>(command.argc(), command.data()));
+  });
+  auto const single = bench::run(direct.tokens(), [&] {
+    bench::do_not_optimize(ParseArgs<Cmd27>(direct.argc(), direct.data()));
+  });
+  bench::print_header();
+  bench::report("subcommand/commands=32", command.tokens(), subcommand);
+  bench::report("direct", direct.tokens(), single);
+}
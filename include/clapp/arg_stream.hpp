@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+#include <unistd.h>
+
+namespace detail {
+
+// Reads null delimited args (like xargs -0, or the output of find -print0)
+// from a file descriptor through a fixed buffer, a window at a time. A window
+// is every arg that is complete in the buffer (up to max_window_args of them),
+// so args are handed on as soon as they arrive, and memory use is bounded by
+// the buffer no matter how many args there are. Each window reuses the buffer,
+// so the args in one are only valid until the next is read.
+class ArgStream {
+public:
+  static constexpr size_t max_window_args = 256;
+
+  enum class Status {
+    Window,
+    // The last window, there is nothing more to read after it
+    Last,
+    // Reading from the file descriptor failed
+    ReadError,
+    // An arg (with the args kept for it) does not fit in the buffer, or the
+    // args kept fill a whole window
+    TooLong,
+  };
+
+  // buffer has to have room for at least one byte past the longest arg, so it
+  // can never be empty
+  ArgStream(int fd, std::span<char> buffer)
+      : fd(fd), data(buffer.data()),
+        capacity(buffer.empty() ? 0 : buffer.size() - 1) {
+    assert(!buffer.empty());
+  }
+
+  // Read the next window, starting it with the last keep args of this one
+  Status next(size_t keep) {
+    // Whatever has not been handed on yet moves to the front of the buffer
+    size_t const from = keep > 0 ? args_[count - keep] - data : consumed;
+    std::memmove(data, data + from, filled - from);
+    filled -= from;
+    count = 0;
+    consumed = 0;
+    while (true) {
+      while (count < max_window_args && consumed < filled) {
+        auto *nul = static_cast<char *>(
+            std::memchr(data + consumed, '\0', filled - consumed));
+        if (nul == nullptr) {
+          break;
+        }
+        args_[count++] = data + consumed;
+        consumed = nul - data + 1;
+      }
+      bool const done = eof && consumed == filled;
+      if (count > keep || done) {
+        return done ? Status::Last : Status::Window;
+      }
+      // Nothing new fits in the window with the args that were kept
+      if (count == max_window_args) {
+        return Status::TooLong;
+      }
+      if (eof) {
+        // The last arg does not have to be terminated, we have the spare
+        // byte to do it for it
+        data[filled++] = '\0';
+        continue;
+      }
+      if (filled == capacity) {
+        return Status::TooLong;
+      }
+      auto const n = ::read(fd, data + filled, capacity - filled);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return Status::ReadError;
+      }
+      eof = n == 0;
+      filled += static_cast<size_t>(n);
+    }
+  }
+
+  // The args in the window we last read
+  std::span<const char *> args() { return {args_.data(), count}; }
+
+private:
+  int fd;
+  char *data;
+  // How much of the buffer we read into, leaving the spare byte
+  size_t capacity;
+  // How many bytes of the buffer hold data
+  size_t filled = 0;
+  // How many of them are in complete args
+  size_t consumed = 0;
+  bool eof = false;
+  std::array<const char *, max_window_args> args_{};
+  size_t count = 0;
+};
+
+} // namespace detail
@@ -0,0 +1,807 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+
+// Structured bindings for every member count we support. Binder<N>::tie(t)
+// returns a tuple of references to each of the N members of t, in declaration
+// order. Each is an ordinary function body, so this is standard C++ (no
+// statement expressions) and is only looked at for the member count we detect
+// for a type (see member_count), rather than once per count for every type.
+// To support more members, bump CLAPP_MAX_MEMBERS and add the matching
+// CLAPP_NAMES_N and CLAPP_BINDER(N) lines.
+
+#define CLAPP_MAX_MEMBERS 256
+
+namespace detail {
+
+template <std::size_t N> struct Binder;
+
+template <> struct Binder<0> {
+  static constexpr auto tie(auto &) { return std::tuple<>(); }
+};
+
+#define CLAPP_BINDER(N)                                                        \
+  template <> struct Binder<N> {                                               \
+    static constexpr auto tie(auto &t) {                                       \
+      auto &[CLAPP_NAMES_##N] = t;                                             \
+      return std::tie(CLAPP_NAMES_##N);                                        \
+    }                                                                          \
+  };
+
+// clang-format off
+#define CLAPP_NAMES_1 _0
+#define CLAPP_NAMES_2 CLAPP_NAMES_1, _1
+#define CLAPP_NAMES_3 CLAPP_NAMES_2, _2
+#define CLAPP_NAMES_4 CLAPP_NAMES_3, _3
+#define CLAPP_NAMES_5 CLAPP_NAMES_4, _4
+#define CLAPP_NAMES_6 CLAPP_NAMES_5, _5
+#define CLAPP_NAMES_7 CLAPP_NAMES_6, _6
+#define CLAPP_NAMES_8 CLAPP_NAMES_7, _7
+#define CLAPP_NAMES_9 CLAPP_NAMES_8, _8
+#define CLAPP_NAMES_10 CLAPP_NAMES_9, _9
+#define CLAPP_NAMES_11 CLAPP_NAMES_10, _10
+#define CLAPP_NAMES_12 CLAPP_NAMES_11, _11
+#define CLAPP_NAMES_13 CLAPP_NAMES_12, _12
+#define CLAPP_NAMES_14 CLAPP_NAMES_13, _13
+#define CLAPP_NAMES_15 CLAPP_NAMES_14, _14
+#define CLAPP_NAMES_16 CLAPP_NAMES_15, _15
+#define CLAPP_NAMES_17 CLAPP_NAMES_16, _16
+#define CLAPP_NAMES_18 CLAPP_NAMES_17, _17
+#define CLAPP_NAMES_19 CLAPP_NAMES_18, _18
+#define CLAPP_NAMES_20 CLAPP_NAMES_19, _19
+#define CLAPP_NAMES_21 CLAPP_NAMES_20, _20
+#define CLAPP_NAMES_22 CLAPP_NAMES_21, _21
+#define CLAPP_NAMES_23 CLAPP_NAMES_22, _22
+#define CLAPP_NAMES_24 CLAPP_NAMES_23, _23
+#define CLAPP_NAMES_25 CLAPP_NAMES_24, _24
+#define CLAPP_NAMES_26 CLAPP_NAMES_25, _25
+#define CLAPP_NAMES_27 CLAPP_NAMES_26, _26
+#define CLAPP_NAMES_28 CLAPP_NAMES_27, _27
+#define CLAPP_NAMES_29 CLAPP_NAMES_28, _28
+#define CLAPP_NAMES_30 CLAPP_NAMES_29, _29
+#define CLAPP_NAMES_31 CLAPP_NAMES_30, _30
+#define CLAPP_NAMES_32 CLAPP_NAMES_31, _31
+#define CLAPP_NAMES_33 CLAPP_NAMES_32, _32
+#define CLAPP_NAMES_34 CLAPP_NAMES_33, _33
+#define CLAPP_NAMES_35 CLAPP_NAMES_34, _34
+#define CLAPP_NAMES_36 CLAPP_NAMES_35, _35
+#define CLAPP_NAMES_37 CLAPP_NAMES_36, _36
+#define CLAPP_NAMES_38 CLAPP_NAMES_37, _37
+#define CLAPP_NAMES_39 CLAPP_NAMES_38, _38
+#define CLAPP_NAMES_40 CLAPP_NAMES_39, _39
+#define CLAPP_NAMES_41 CLAPP_NAMES_40, _40
+#define CLAPP_NAMES_42 CLAPP_NAMES_41, _41
+#define CLAPP_NAMES_43 CLAPP_NAMES_42, _42
+#define CLAPP_NAMES_44 CLAPP_NAMES_43, _43
+#define CLAPP_NAMES_45 CLAPP_NAMES_44, _44
+#define CLAPP_NAMES_46 CLAPP_NAMES_45, _45
+#define CLAPP_NAMES_47 CLAPP_NAMES_46, _46
+#define CLAPP_NAMES_48 CLAPP_NAMES_47, _47
+#define CLAPP_NAMES_49 CLAPP_NAMES_48, _48
+#define CLAPP_NAMES_50 CLAPP_NAMES_49, _49
+#define CLAPP_NAMES_51 CLAPP_NAMES_50, _50
+#define CLAPP_NAMES_52 CLAPP_NAMES_51, _51
+#define CLAPP_NAMES_53 CLAPP_NAMES_52, _52
+#define CLAPP_NAMES_54 CLAPP_NAMES_53, _53
+#define CLAPP_NAMES_55 CLAPP_NAMES_54, _54
+#define CLAPP_NAMES_56 CLAPP_NAMES_55, _55
+#define CLAPP_NAMES_57 CLAPP_NAMES_56, _56
+#define CLAPP_NAMES_58 CLAPP_NAMES_57, _57
+#define CLAPP_NAMES_59 CLAPP_NAMES_58, _58
+#define CLAPP_NAMES_60 CLAPP_NAMES_59, _59
+#define CLAPP_NAMES_61 CLAPP_NAMES_60, _60
+#define CLAPP_NAMES_62 CLAPP_NAMES_61, _61
+#define CLAPP_NAMES_63 CLAPP_NAMES_62, _62
+#define CLAPP_NAMES_64 CLAPP_NAMES_63, _63
+#define CLAPP_NAMES_65 CLAPP_NAMES_64, _64
+#define CLAPP_NAMES_66 CLAPP_NAMES_65, _65
+#define CLAPP_NAMES_67 CLAPP_NAMES_66, _66
+#define CLAPP_NAMES_68 CLAPP_NAMES_67, _67
+#define CLAPP_NAMES_69 CLAPP_NAMES_68, _68
+#define CLAPP_NAMES_70 CLAPP_NAMES_69, _69
+#define CLAPP_NAMES_71 CLAPP_NAMES_70, _70
+#define CLAPP_NAMES_72 CLAPP_NAMES_71, _71
+#define CLAPP_NAMES_73 CLAPP_NAMES_72, _72
+#define CLAPP_NAMES_74 CLAPP_NAMES_73, _73
+#define CLAPP_NAMES_75 CLAPP_NAMES_74, _74
+#define CLAPP_NAMES_76 CLAPP_NAMES_75, _75
+#define CLAPP_NAMES_77 CLAPP_NAMES_76, _76
+#define CLAPP_NAMES_78 CLAPP_NAMES_77, _77
+#define CLAPP_NAMES_79 CLAPP_NAMES_78, _78
+#define CLAPP_NAMES_80 CLAPP_NAMES_79, _79
+#define CLAPP_NAMES_81 CLAPP_NAMES_80, _80
+#define CLAPP_NAMES_82 CLAPP_NAMES_81, _81
+#define CLAPP_NAMES_83 CLAPP_NAMES_82, _82
+#define CLAPP_NAMES_84 CLAPP_NAMES_83, _83
+#define CLAPP_NAMES_85 CLAPP_NAMES_84, _84
+#define CLAPP_NAMES_86 CLAPP_NAMES_85, _85
+#define CLAPP_NAMES_87 CLAPP_NAMES_86, _86
+#define CLAPP_NAMES_88 CLAPP_NAMES_87, _87
+#define CLAPP_NAMES_89 CLAPP_NAMES_88, _88
+#define CLAPP_NAMES_90 CLAPP_NAMES_89, _89
+#define CLAPP_NAMES_91 CLAPP_NAMES_90, _90
+#define CLAPP_NAMES_92 CLAPP_NAMES_91, _91
+#define CLAPP_NAMES_93 CLAPP_NAMES_92, _92
+#define CLAPP_NAMES_94 CLAPP_NAMES_93, _93
+#define CLAPP_NAMES_95 CLAPP_NAMES_94, _94
+#define CLAPP_NAMES_96 CLAPP_NAMES_95, _95
+#define CLAPP_NAMES_97 CLAPP_NAMES_96, _96
+#define CLAPP_NAMES_98 CLAPP_NAMES_97, _97
+#define CLAPP_NAMES_99 CLAPP_NAMES_98, _98
+#define CLAPP_NAMES_100 CLAPP_NAMES_99, _99
+#define CLAPP_NAMES_101 CLAPP_NAMES_100, _100
+#define CLAPP_NAMES_102 CLAPP_NAMES_101, _101
+#define CLAPP_NAMES_103 CLAPP_NAMES_102, _102
+#define CLAPP_NAMES_104 CLAPP_NAMES_103, _103
+#define CLAPP_NAMES_105 CLAPP_NAMES_104, _104
+#define CLAPP_NAMES_106 CLAPP_NAMES_105, _105
+#define CLAPP_NAMES_107 CLAPP_NAMES_106, _106
+#define CLAPP_NAMES_108 CLAPP_NAMES_107, _107
+#define CLAPP_NAMES_109 CLAPP_NAMES_108, _108
+#define CLAPP_NAMES_110 CLAPP_NAMES_109, _109
+#define CLAPP_NAMES_111 CLAPP_NAMES_110, _110
+#define CLAPP_NAMES_112 CLAPP_NAMES_111, _111
+#define CLAPP_NAMES_113 CLAPP_NAMES_112, _112
+#define CLAPP_NAMES_114 CLAPP_NAMES_113, _113
+#define CLAPP_NAMES_115 CLAPP_NAMES_114, _114
+#define CLAPP_NAMES_116 CLAPP_NAMES_115, _115
+#define CLAPP_NAMES_117 CLAPP_NAMES_116, _116
+#define CLAPP_NAMES_118 CLAPP_NAMES_117, _117
+#define CLAPP_NAMES_119 CLAPP_NAMES_118, _118
+#define CLAPP_NAMES_120 CLAPP_NAMES_119, _119
+#define CLAPP_NAMES_121 CLAPP_NAMES_120, _120
+#define CLAPP_NAMES_122 CLAPP_NAMES_121, _121
+#define CLAPP_NAMES_123 CLAPP_NAMES_122, _122
+#define CLAPP_NAMES_124 CLAPP_NAMES_123, _123
+#define CLAPP_NAMES_125 CLAPP_NAMES_124, _124
+#define CLAPP_NAMES_126 CLAPP_NAMES_125, _125
+#define CLAPP_NAMES_127 CLAPP_NAMES_126, _126
+#define CLAPP_NAMES_128 CLAPP_NAMES_127, _127
+#define CLAPP_NAMES_129 CLAPP_NAMES_128, _128
+#define CLAPP_NAMES_130 CLAPP_NAMES_129, _129
+#define CLAPP_NAMES_131 CLAPP_NAMES_130, _130
+#define CLAPP_NAMES_132 CLAPP_NAMES_131, _131
+#define CLAPP_NAMES_133 CLAPP_NAMES_132, _132
+#define CLAPP_NAMES_134 CLAPP_NAMES_133, _133
+#define CLAPP_NAMES_135 CLAPP_NAMES_134, _134
+#define CLAPP_NAMES_136 CLAPP_NAMES_135, _135
+#define CLAPP_NAMES_137 CLAPP_NAMES_136, _136
+#define CLAPP_NAMES_138 CLAPP_NAMES_137, _137
+#define CLAPP_NAMES_139 CLAPP_NAMES_138, _138
+#define CLAPP_NAMES_140 CLAPP_NAMES_139, _139
+#define CLAPP_NAMES_141 CLAPP_NAMES_140, _140
+#define CLAPP_NAMES_142 CLAPP_NAMES_141, _141
+#define CLAPP_NAMES_143 CLAPP_NAMES_142, _142
+#define CLAPP_NAMES_144 CLAPP_NAMES_143, _143
+#define CLAPP_NAMES_145 CLAPP_NAMES_144, _144
+#define CLAPP_NAMES_146 CLAPP_NAMES_145, _145
+#define CLAPP_NAMES_147 CLAPP_NAMES_146, _146
+#define CLAPP_NAMES_148 CLAPP_NAMES_147, _147
+#define CLAPP_NAMES_149 CLAPP_NAMES_148, _148
+#define CLAPP_NAMES_150 CLAPP_NAMES_149, _149
+#define CLAPP_NAMES_151 CLAPP_NAMES_150, _150
+#define CLAPP_NAMES_152 CLAPP_NAMES_151, _151
+#define CLAPP_NAMES_153 CLAPP_NAMES_152, _152
+#define CLAPP_NAMES_154 CLAPP_NAMES_153, _153
+#define CLAPP_NAMES_155 CLAPP_NAMES_154, _154
+#define CLAPP_NAMES_156 CLAPP_NAMES_155, _155
+#define CLAPP_NAMES_157 CLAPP_NAMES_156, _156
+#define CLAPP_NAMES_158 CLAPP_NAMES_157, _157
+#define CLAPP_NAMES_159 CLAPP_NAMES_158, _158
+#define CLAPP_NAMES_160 CLAPP_NAMES_159, _159
+#define CLAPP_NAMES_161 CLAPP_NAMES_160, _160
+#define CLAPP_NAMES_162 CLAPP_NAMES_161, _161
+#define CLAPP_NAMES_163 CLAPP_NAMES_162, _162
+#define CLAPP_NAMES_164 CLAPP_NAMES_163, _163
+#define CLAPP_NAMES_165 CLAPP_NAMES_164, _164
+#define CLAPP_NAMES_166 CLAPP_NAMES_165, _165
+#define CLAPP_NAMES_167 CLAPP_NAMES_166, _166
+#define CLAPP_NAMES_168 CLAPP_NAMES_167, _167
+#define CLAPP_NAMES_169 CLAPP_NAMES_168, _168
+#define CLAPP_NAMES_170 CLAPP_NAMES_169, _169
+#define CLAPP_NAMES_171 CLAPP_NAMES_170, _170
+#define CLAPP_NAMES_172 CLAPP_NAMES_171, _171
+#define CLAPP_NAMES_173 CLAPP_NAMES_172, _172
+#define CLAPP_NAMES_174 CLAPP_NAMES_173, _173
+#define CLAPP_NAMES_175 CLAPP_NAMES_174, _174
+#define CLAPP_NAMES_176 CLAPP_NAMES_175, _175
+#define CLAPP_NAMES_177 CLAPP_NAMES_176, _176
+#define CLAPP_NAMES_178 CLAPP_NAMES_177, _177
+#define CLAPP_NAMES_179 CLAPP_NAMES_178, _178
+#define CLAPP_NAMES_180 CLAPP_NAMES_179, _179
+#define CLAPP_NAMES_181 CLAPP_NAMES_180, _180
+#define CLAPP_NAMES_182 CLAPP_NAMES_181, _181
+#define CLAPP_NAMES_183 CLAPP_NAMES_182, _182
+#define CLAPP_NAMES_184 CLAPP_NAMES_183, _183
+#define CLAPP_NAMES_185 CLAPP_NAMES_184, _184
+#define CLAPP_NAMES_186 CLAPP_NAMES_185, _185
+#define CLAPP_NAMES_187 CLAPP_NAMES_186, _186
+#define CLAPP_NAMES_188 CLAPP_NAMES_187, _187
+#define CLAPP_NAMES_189 CLAPP_NAMES_188, _188
+#define CLAPP_NAMES_190 CLAPP_NAMES_189, _189
+#define CLAPP_NAMES_191 CLAPP_NAMES_190, _190
+#define CLAPP_NAMES_192 CLAPP_NAMES_191, _191
+#define CLAPP_NAMES_193 CLAPP_NAMES_192, _192
+#define CLAPP_NAMES_194 CLAPP_NAMES_193, _193
+#define CLAPP_NAMES_195 CLAPP_NAMES_194, _194
+#define CLAPP_NAMES_196 CLAPP_NAMES_195, _195
+#define CLAPP_NAMES_197 CLAPP_NAMES_196, _196
+#define CLAPP_NAMES_198 CLAPP_NAMES_197, _197
+#define CLAPP_NAMES_199 CLAPP_NAMES_198, _198
+#define CLAPP_NAMES_200 CLAPP_NAMES_199, _199
+#define CLAPP_NAMES_201 CLAPP_NAMES_200, _200
+#define CLAPP_NAMES_202 CLAPP_NAMES_201, _201
+#define CLAPP_NAMES_203 CLAPP_NAMES_202, _202
+#define CLAPP_NAMES_204 CLAPP_NAMES_203, _203
+#define CLAPP_NAMES_205 CLAPP_NAMES_204, _204
+#define CLAPP_NAMES_206 CLAPP_NAMES_205, _205
+#define CLAPP_NAMES_207 CLAPP_NAMES_206, _206
+#define CLAPP_NAMES_208 CLAPP_NAMES_207, _207
+#define CLAPP_NAMES_209 CLAPP_NAMES_208, _208
+#define CLAPP_NAMES_210 CLAPP_NAMES_209, _209
+#define CLAPP_NAMES_211 CLAPP_NAMES_210, _210
+#define CLAPP_NAMES_212 CLAPP_NAMES_211, _211
+#define CLAPP_NAMES_213 CLAPP_NAMES_212, _212
+#define CLAPP_NAMES_214 CLAPP_NAMES_213, _213
+#define CLAPP_NAMES_215 CLAPP_NAMES_214, _214
+#define CLAPP_NAMES_216 CLAPP_NAMES_215, _215
+#define CLAPP_NAMES_217 CLAPP_NAMES_216, _216
+#define CLAPP_NAMES_218 CLAPP_NAMES_217, _217
+#define CLAPP_NAMES_219 CLAPP_NAMES_218, _218
+#define CLAPP_NAMES_220 CLAPP_NAMES_219, _219
+#define CLAPP_NAMES_221 CLAPP_NAMES_220, _220
+#define CLAPP_NAMES_222 CLAPP_NAMES_221, _221
+#define CLAPP_NAMES_223 CLAPP_NAMES_222, _222
+#define CLAPP_NAMES_224 CLAPP_NAMES_223, _223
+#define CLAPP_NAMES_225 CLAPP_NAMES_224, _224
+#define CLAPP_NAMES_226 CLAPP_NAMES_225, _225
+#define CLAPP_NAMES_227 CLAPP_NAMES_226, _226
+#define CLAPP_NAMES_228 CLAPP_NAMES_227, _227
+#define CLAPP_NAMES_229 CLAPP_NAMES_228, _228
+#define CLAPP_NAMES_230 CLAPP_NAMES_229, _229
+#define CLAPP_NAMES_231 CLAPP_NAMES_230, _230
+#define CLAPP_NAMES_232 CLAPP_NAMES_231, _231
+#define CLAPP_NAMES_233 CLAPP_NAMES_232, _232
+#define CLAPP_NAMES_234 CLAPP_NAMES_233, _233
+#define CLAPP_NAMES_235 CLAPP_NAMES_234, _234
+#define CLAPP_NAMES_236 CLAPP_NAMES_235, _235
+#define CLAPP_NAMES_237 CLAPP_NAMES_236, _236
+#define CLAPP_NAMES_238 CLAPP_NAMES_237, _237
+#define CLAPP_NAMES_239 CLAPP_NAMES_238, _238
+#define CLAPP_NAMES_240 CLAPP_NAMES_239, _239
+#define CLAPP_NAMES_241 CLAPP_NAMES_240, _240
+#define CLAPP_NAMES_242 CLAPP_NAMES_241, _241
+#define CLAPP_NAMES_243 CLAPP_NAMES_242, _242
+#define CLAPP_NAMES_244 CLAPP_NAMES_243, _243
+#define CLAPP_NAMES_245 CLAPP_NAMES_244, _244
+#define CLAPP_NAMES_246 CLAPP_NAMES_245, _245
+#define CLAPP_NAMES_247 CLAPP_NAMES_246, _246
+#define CLAPP_NAMES_248 CLAPP_NAMES_247, _247
+#define CLAPP_NAMES_249 CLAPP_NAMES_248, _248
+#define CLAPP_NAMES_250 CLAPP_NAMES_249, _249
+#define CLAPP_NAMES_251 CLAPP_NAMES_250, _250
+#define CLAPP_NAMES_252 CLAPP_NAMES_251, _251
+#define CLAPP_NAMES_253 CLAPP_NAMES_252, _252
+#define CLAPP_NAMES_254 CLAPP_NAMES_253, _253
+#define CLAPP_NAMES_255 CLAPP_NAMES_254, _254
+#define CLAPP_NAMES_256 CLAPP_NAMES_255, _255
+
+CLAPP_BINDER(1)
+CLAPP_BINDER(2)
+CLAPP_BINDER(3)
+CLAPP_BINDER(4)
+CLAPP_BINDER(5)
+CLAPP_BINDER(6)
+CLAPP_BINDER(7)
+CLAPP_BINDER(8)
+CLAPP_BINDER(9)
+CLAPP_BINDER(10)
+CLAPP_BINDER(11)
+CLAPP_BINDER(12)
+CLAPP_BINDER(13)
+CLAPP_BINDER(14)
+CLAPP_BINDER(15)
+CLAPP_BINDER(16)
+CLAPP_BINDER(17)
+CLAPP_BINDER(18)
+CLAPP_BINDER(19)
+CLAPP_BINDER(20)
+CLAPP_BINDER(21)
+CLAPP_BINDER(22)
+CLAPP_BINDER(23)
+CLAPP_BINDER(24)
+CLAPP_BINDER(25)
+CLAPP_BINDER(26)
+CLAPP_BINDER(27)
+CLAPP_BINDER(28)
+CLAPP_BINDER(29)
+CLAPP_BINDER(30)
+CLAPP_BINDER(31)
+CLAPP_BINDER(32)
+CLAPP_BINDER(33)
+CLAPP_BINDER(34)
+CLAPP_BINDER(35)
+CLAPP_BINDER(36)
+CLAPP_BINDER(37)
+CLAPP_BINDER(38)
+CLAPP_BINDER(39)
+CLAPP_BINDER(40)
+CLAPP_BINDER(41)
+CLAPP_BINDER(42)
+CLAPP_BINDER(43)
+CLAPP_BINDER(44)
+CLAPP_BINDER(45)
+CLAPP_BINDER(46)
+CLAPP_BINDER(47)
+CLAPP_BINDER(48)
+CLAPP_BINDER(49)
+CLAPP_BINDER(50)
+CLAPP_BINDER(51)
+CLAPP_BINDER(52)
+CLAPP_BINDER(53)
+CLAPP_BINDER(54)
+CLAPP_BINDER(55)
+CLAPP_BINDER(56)
+CLAPP_BINDER(57)
+CLAPP_BINDER(58)
+CLAPP_BINDER(59)
+CLAPP_BINDER(60)
+CLAPP_BINDER(61)
+CLAPP_BINDER(62)
+CLAPP_BINDER(63)
+CLAPP_BINDER(64)
+CLAPP_BINDER(65)
+CLAPP_BINDER(66)
+CLAPP_BINDER(67)
+CLAPP_BINDER(68)
+CLAPP_BINDER(69)
+CLAPP_BINDER(70)
+CLAPP_BINDER(71)
+CLAPP_BINDER(72)
+CLAPP_BINDER(73)
+CLAPP_BINDER(74)
+CLAPP_BINDER(75)
+CLAPP_BINDER(76)
+CLAPP_BINDER(77)
+CLAPP_BINDER(78)
+CLAPP_BINDER(79)
+CLAPP_BINDER(80)
+CLAPP_BINDER(81)
+CLAPP_BINDER(82)
+CLAPP_BINDER(83)
+CLAPP_BINDER(84)
+CLAPP_BINDER(85)
+CLAPP_BINDER(86)
+CLAPP_BINDER(87)
+CLAPP_BINDER(88)
+CLAPP_BINDER(89)
+CLAPP_BINDER(90)
+CLAPP_BINDER(91)
+CLAPP_BINDER(92)
+CLAPP_BINDER(93)
+CLAPP_BINDER(94)
+CLAPP_BINDER(95)
+CLAPP_BINDER(96)
+CLAPP_BINDER(97)
+CLAPP_BINDER(98)
+CLAPP_BINDER(99)
+CLAPP_BINDER(100)
+CLAPP_BINDER(101)
+CLAPP_BINDER(102)
+CLAPP_BINDER(103)
+CLAPP_BINDER(104)
+CLAPP_BINDER(105)
+CLAPP_BINDER(106)
+CLAPP_BINDER(107)
+CLAPP_BINDER(108)
+CLAPP_BINDER(109)
+CLAPP_BINDER(110)
+CLAPP_BINDER(111)
+CLAPP_BINDER(112)
+CLAPP_BINDER(113)
+CLAPP_BINDER(114)
+CLAPP_BINDER(115)
+CLAPP_BINDER(116)
+CLAPP_BINDER(117)
+CLAPP_BINDER(118)
+CLAPP_BINDER(119)
+CLAPP_BINDER(120)
+CLAPP_BINDER(121)
+CLAPP_BINDER(122)
+CLAPP_BINDER(123)
+CLAPP_BINDER(124)
+CLAPP_BINDER(125)
+CLAPP_BINDER(126)
+CLAPP_BINDER(127)
+CLAPP_BINDER(128)
+CLAPP_BINDER(129)
+CLAPP_BINDER(130)
+CLAPP_BINDER(131)
+CLAPP_BINDER(132)
+CLAPP_BINDER(133)
+CLAPP_BINDER(134)
+CLAPP_BINDER(135)
+CLAPP_BINDER(136)
+CLAPP_BINDER(137)
+CLAPP_BINDER(138)
+CLAPP_BINDER(139)
+CLAPP_BINDER(140)
+CLAPP_BINDER(141)
+CLAPP_BINDER(142)
+CLAPP_BINDER(143)
+CLAPP_BINDER(144)
+CLAPP_BINDER(145)
+CLAPP_BINDER(146)
+CLAPP_BINDER(147)
+CLAPP_BINDER(148)
+CLAPP_BINDER(149)
+CLAPP_BINDER(150)
+CLAPP_BINDER(151)
+CLAPP_BINDER(152)
+CLAPP_BINDER(153)
+CLAPP_BINDER(154)
+CLAPP_BINDER(155)
+CLAPP_BINDER(156)
+CLAPP_BINDER(157)
+CLAPP_BINDER(158)
+CLAPP_BINDER(159)
+CLAPP_BINDER(160)
+CLAPP_BINDER(161)
+CLAPP_BINDER(162)
+CLAPP_BINDER(163)
+CLAPP_BINDER(164)
+CLAPP_BINDER(165)
+CLAPP_BINDER(166)
+CLAPP_BINDER(167)
+CLAPP_BINDER(168)
+CLAPP_BINDER(169)
+CLAPP_BINDER(170)
+CLAPP_BINDER(171)
+CLAPP_BINDER(172)
+CLAPP_BINDER(173)
+CLAPP_BINDER(174)
+CLAPP_BINDER(175)
+CLAPP_BINDER(176)
+CLAPP_BINDER(177)
+CLAPP_BINDER(178)
+CLAPP_BINDER(179)
+CLAPP_BINDER(180)
+CLAPP_BINDER(181)
+CLAPP_BINDER(182)
+CLAPP_BINDER(183)
+CLAPP_BINDER(184)
+CLAPP_BINDER(185)
+CLAPP_BINDER(186)
+CLAPP_BINDER(187)
+CLAPP_BINDER(188)
+CLAPP_BINDER(189)
+CLAPP_BINDER(190)
+CLAPP_BINDER(191)
+CLAPP_BINDER(192)
+CLAPP_BINDER(193)
+CLAPP_BINDER(194)
+CLAPP_BINDER(195)
+CLAPP_BINDER(196)
+CLAPP_BINDER(197)
+CLAPP_BINDER(198)
+CLAPP_BINDER(199)
+CLAPP_BINDER(200)
+CLAPP_BINDER(201)
+CLAPP_BINDER(202)
+CLAPP_BINDER(203)
+CLAPP_BINDER(204)
+CLAPP_BINDER(205)
+CLAPP_BINDER(206)
+CLAPP_BINDER(207)
+CLAPP_BINDER(208)
+CLAPP_BINDER(209)
+CLAPP_BINDER(210)
+CLAPP_BINDER(211)
+CLAPP_BINDER(212)
+CLAPP_BINDER(213)
+CLAPP_BINDER(214)
+CLAPP_BINDER(215)
+CLAPP_BINDER(216)
+CLAPP_BINDER(217)
+CLAPP_BINDER(218)
+CLAPP_BINDER(219)
+CLAPP_BINDER(220)
+CLAPP_BINDER(221)
+CLAPP_BINDER(222)
+CLAPP_BINDER(223)
+CLAPP_BINDER(224)
+CLAPP_BINDER(225)
+CLAPP_BINDER(226)
+CLAPP_BINDER(227)
+CLAPP_BINDER(228)
+CLAPP_BINDER(229)
+CLAPP_BINDER(230)
+CLAPP_BINDER(231)
+CLAPP_BINDER(232)
+CLAPP_BINDER(233)
+CLAPP_BINDER(234)
+CLAPP_BINDER(235)
+CLAPP_BINDER(236)
+CLAPP_BINDER(237)
+CLAPP_BINDER(238)
+CLAPP_BINDER(239)
+CLAPP_BINDER(240)
+CLAPP_BINDER(241)
+CLAPP_BINDER(242)
+CLAPP_BINDER(243)
+CLAPP_BINDER(244)
+CLAPP_BINDER(245)
+CLAPP_BINDER(246)
+CLAPP_BINDER(247)
+CLAPP_BINDER(248)
+CLAPP_BINDER(249)
+CLAPP_BINDER(250)
+CLAPP_BINDER(251)
+CLAPP_BINDER(252)
+CLAPP_BINDER(253)
+CLAPP_BINDER(254)
+CLAPP_BINDER(255)
+CLAPP_BINDER(256)
+
+#undef CLAPP_NAMES_1
+#undef CLAPP_NAMES_2
+#undef CLAPP_NAMES_3
+#undef CLAPP_NAMES_4
+#undef CLAPP_NAMES_5
+#undef CLAPP_NAMES_6
+#undef CLAPP_NAMES_7
+#undef CLAPP_NAMES_8
+#undef CLAPP_NAMES_9
+#undef CLAPP_NAMES_10
+#undef CLAPP_NAMES_11
+#undef CLAPP_NAMES_12
+#undef CLAPP_NAMES_13
+#undef CLAPP_NAMES_14
+#undef CLAPP_NAMES_15
+#undef CLAPP_NAMES_16
+#undef CLAPP_NAMES_17
+#undef CLAPP_NAMES_18
+#undef CLAPP_NAMES_19
+#undef CLAPP_NAMES_20
+#undef CLAPP_NAMES_21
+#undef CLAPP_NAMES_22
+#undef CLAPP_NAMES_23
+#undef CLAPP_NAMES_24
+#undef CLAPP_NAMES_25
+#undef CLAPP_NAMES_26
+#undef CLAPP_NAMES_27
+#undef CLAPP_NAMES_28
+#undef CLAPP_NAMES_29
+#undef CLAPP_NAMES_30
+#undef CLAPP_NAMES_31
+#undef CLAPP_NAMES_32
+#undef CLAPP_NAMES_33
+#undef CLAPP_NAMES_34
+#undef CLAPP_NAMES_35
+#undef CLAPP_NAMES_36
+#undef CLAPP_NAMES_37
+#undef CLAPP_NAMES_38
+#undef CLAPP_NAMES_39
+#undef CLAPP_NAMES_40
+#undef CLAPP_NAMES_41
+#undef CLAPP_NAMES_42
+#undef CLAPP_NAMES_43
+#undef CLAPP_NAMES_44
+#undef CLAPP_NAMES_45
+#undef CLAPP_NAMES_46
+#undef CLAPP_NAMES_47
+#undef CLAPP_NAMES_48
+#undef CLAPP_NAMES_49
+#undef CLAPP_NAMES_50
+#undef CLAPP_NAMES_51
+#undef CLAPP_NAMES_52
+#undef CLAPP_NAMES_53
+#undef CLAPP_NAMES_54
+#undef CLAPP_NAMES_55
+#undef CLAPP_NAMES_56
+#undef CLAPP_NAMES_57
+#undef CLAPP_NAMES_58
+#undef CLAPP_NAMES_59
+#undef CLAPP_NAMES_60
+#undef CLAPP_NAMES_61
+#undef CLAPP_NAMES_62
+#undef CLAPP_NAMES_63
+#undef CLAPP_NAMES_64
+#undef CLAPP_NAMES_65
+#undef CLAPP_NAMES_66
+#undef CLAPP_NAMES_67
+#undef CLAPP_NAMES_68
+#undef CLAPP_NAMES_69
+#undef CLAPP_NAMES_70
+#undef CLAPP_NAMES_71
+#undef CLAPP_NAMES_72
+#undef CLAPP_NAMES_73
+#undef CLAPP_NAMES_74
+#undef CLAPP_NAMES_75
+#undef CLAPP_NAMES_76
+#undef CLAPP_NAMES_77
+#undef CLAPP_NAMES_78
+#undef CLAPP_NAMES_79
+#undef CLAPP_NAMES_80
+#undef CLAPP_NAMES_81
+#undef CLAPP_NAMES_82
+#undef CLAPP_NAMES_83
+#undef CLAPP_NAMES_84
+#undef CLAPP_NAMES_85
+#undef CLAPP_NAMES_86
+#undef CLAPP_NAMES_87
+#undef CLAPP_NAMES_88
+#undef CLAPP_NAMES_89
+#undef CLAPP_NAMES_90
+#undef CLAPP_NAMES_91
+#undef CLAPP_NAMES_92
+#undef CLAPP_NAMES_93
+#undef CLAPP_NAMES_94
+#undef CLAPP_NAMES_95
+#undef CLAPP_NAMES_96
+#undef CLAPP_NAMES_97
+#undef CLAPP_NAMES_98
+#undef CLAPP_NAMES_99
+#undef CLAPP_NAMES_100
+#undef CLAPP_NAMES_101
+#undef CLAPP_NAMES_102
+#undef CLAPP_NAMES_103
+#undef CLAPP_NAMES_104
+#undef CLAPP_NAMES_105
+#undef CLAPP_NAMES_106
+#undef CLAPP_NAMES_107
+#undef CLAPP_NAMES_108
+#undef CLAPP_NAMES_109
+#undef CLAPP_NAMES_110
+#undef CLAPP_NAMES_111
+#undef CLAPP_NAMES_112
+#undef CLAPP_NAMES_113
+#undef CLAPP_NAMES_114
+#undef CLAPP_NAMES_115
+#undef CLAPP_NAMES_116
+#undef CLAPP_NAMES_117
+#undef CLAPP_NAMES_118
+#undef CLAPP_NAMES_119
+#undef CLAPP_NAMES_120
+#undef CLAPP_NAMES_121
+#undef CLAPP_NAMES_122
+#undef CLAPP_NAMES_123
+#undef CLAPP_NAMES_124
+#undef CLAPP_NAMES_125
+#undef CLAPP_NAMES_126
+#undef CLAPP_NAMES_127
+#undef CLAPP_NAMES_128
+#undef CLAPP_NAMES_129
+#undef CLAPP_NAMES_130
+#undef CLAPP_NAMES_131
+#undef CLAPP_NAMES_132
+#undef CLAPP_NAMES_133
+#undef CLAPP_NAMES_134
+#undef CLAPP_NAMES_135
+#undef CLAPP_NAMES_136
+#undef CLAPP_NAMES_137
+#undef CLAPP_NAMES_138
+#undef CLAPP_NAMES_139
+#undef CLAPP_NAMES_140
+#undef CLAPP_NAMES_141
+#undef CLAPP_NAMES_142
+#undef CLAPP_NAMES_143
+#undef CLAPP_NAMES_144
+#undef CLAPP_NAMES_145
+#undef CLAPP_NAMES_146
+#undef CLAPP_NAMES_147
+#undef CLAPP_NAMES_148
+#undef CLAPP_NAMES_149
+#undef CLAPP_NAMES_150
+#undef CLAPP_NAMES_151
+#undef CLAPP_NAMES_152
+#undef CLAPP_NAMES_153
+#undef CLAPP_NAMES_154
+#undef CLAPP_NAMES_155
+#undef CLAPP_NAMES_156
+#undef CLAPP_NAMES_157
+#undef CLAPP_NAMES_158
+#undef CLAPP_NAMES_159
+#undef CLAPP_NAMES_160
+#undef CLAPP_NAMES_161
+#undef CLAPP_NAMES_162
+#undef CLAPP_NAMES_163
+#undef CLAPP_NAMES_164
+#undef CLAPP_NAMES_165
+#undef CLAPP_NAMES_166
+#undef CLAPP_NAMES_167
+#undef CLAPP_NAMES_168
+#undef CLAPP_NAMES_169
+#undef CLAPP_NAMES_170
+#undef CLAPP_NAMES_171
+#undef CLAPP_NAMES_172
+#undef CLAPP_NAMES_173
+#undef CLAPP_NAMES_174
+#undef CLAPP_NAMES_175
+#undef CLAPP_NAMES_176
+#undef CLAPP_NAMES_177
+#undef CLAPP_NAMES_178
+#undef CLAPP_NAMES_179
+#undef CLAPP_NAMES_180
+#undef CLAPP_NAMES_181
+#undef CLAPP_NAMES_182
+#undef CLAPP_NAMES_183
+#undef CLAPP_NAMES_184
+#undef CLAPP_NAMES_185
+#undef CLAPP_NAMES_186
+#undef CLAPP_NAMES_187
+#undef CLAPP_NAMES_188
+#undef CLAPP_NAMES_189
+#undef CLAPP_NAMES_190
+#undef CLAPP_NAMES_191
+#undef CLAPP_NAMES_192
+#undef CLAPP_NAMES_193
+#undef CLAPP_NAMES_194
+#undef CLAPP_NAMES_195
+#undef CLAPP_NAMES_196
+#undef CLAPP_NAMES_197
+#undef CLAPP_NAMES_198
+#undef CLAPP_NAMES_199
+#undef CLAPP_NAMES_200
+#undef CLAPP_NAMES_201
+#undef CLAPP_NAMES_202
+#undef CLAPP_NAMES_203
+#undef CLAPP_NAMES_204
+#undef CLAPP_NAMES_205
+#undef CLAPP_NAMES_206
+#undef CLAPP_NAMES_207
+#undef CLAPP_NAMES_208
+#undef CLAPP_NAMES_209
+#undef CLAPP_NAMES_210
+#undef CLAPP_NAMES_211
+#undef CLAPP_NAMES_212
+#undef CLAPP_NAMES_213
+#undef CLAPP_NAMES_214
+#undef CLAPP_NAMES_215
+#undef CLAPP_NAMES_216
+#undef CLAPP_NAMES_217
+#undef CLAPP_NAMES_218
+#undef CLAPP_NAMES_219
+#undef CLAPP_NAMES_220
+#undef CLAPP_NAMES_221
+#undef CLAPP_NAMES_222
+#undef CLAPP_NAMES_223
+#undef CLAPP_NAMES_224
+#undef CLAPP_NAMES_225
+#undef CLAPP_NAMES_226
+#undef CLAPP_NAMES_227
+#undef CLAPP_NAMES_228
+#undef CLAPP_NAMES_229
+#undef CLAPP_NAMES_230
+#undef CLAPP_NAMES_231
+#undef CLAPP_NAMES_232
+#undef CLAPP_NAMES_233
+#undef CLAPP_NAMES_234
+#undef CLAPP_NAMES_235
+#undef CLAPP_NAMES_236
+#undef CLAPP_NAMES_237
+#undef CLAPP_NAMES_238
+#undef CLAPP_NAMES_239
+#undef CLAPP_NAMES_240
+#undef CLAPP_NAMES_241
+#undef CLAPP_NAMES_242
+#undef CLAPP_NAMES_243
+#undef CLAPP_NAMES_244
+#undef CLAPP_NAMES_245
+#undef CLAPP_NAMES_246
+#undef CLAPP_NAMES_247
+#undef CLAPP_NAMES_248
+#undef CLAPP_NAMES_249
+#undef CLAPP_NAMES_250
+#undef CLAPP_NAMES_251
+#undef CLAPP_NAMES_252
+#undef CLAPP_NAMES_253
+#undef CLAPP_NAMES_254
+#undef CLAPP_NAMES_255
+#undef CLAPP_NAMES_256
+// clang-format on
+
+#undef CLAPP_BINDER
+
+} // namespace detail
@@ -1,21 +1,39 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <cassert>
+#include <unistd.h>
 
-#include "macro_sequence_for.h"
+#include "arg_stream.hpp"
+#include "bindings.hpp"
+#include "config_file.hpp"
+#include "mapped_file.hpp"
+
+// The environment of the process, see environ(7)
+extern char **environ;
 
 // SFINAE for determining how many members we have
 // THEN, we try each, attempting to perform an argument parse from each
@@ -23,8 +41,114 @@
 // The argument parser specialization
 template <class T> struct ArgParse;
 
-// If we failed to convert into a type
-struct ParseError {};
+namespace detail {
+
+// A fixed size set of member indices, one bit each. Unlike std::bitset it can
+// be used in constant evaluation, and whole sets can be compared a word at a
+// time.
+template <size_t N> struct MemberSet {
+  std::array<std::uint64_t, (N + 63) / 64> words{};
+
+  constexpr void set(size_t i) {
+    words[i / 64] |= std::uint64_t{1} << (i % 64);
+  }
+  constexpr bool test(size_t i) const {
+    return (words[i / 64] >> (i % 64)) & 1;
+  }
+  // The members in this set that are not in other
+  constexpr MemberSet without(MemberSet const &other) const {
+    MemberSet result;
+    for (size_t w = 0; w < words.size(); w++) {
+      result.words[w] = words[w] & ~other.words[w];
+    }
+    return result;
+  }
+  // How many members are in the set
+  constexpr size_t count() const {
+    size_t n = 0;
+    for (auto const word : words) {
+      n += static_cast<size_t>(std::popcount(word));
+    }
+    return n;
+  }
+  constexpr bool any() const {
+    return std::any_of(words.begin(), words.end(),
+                       [](std::uint64_t word) { return word != 0; });
+  }
+  // The lowest member in the set, or N if it is empty
+  constexpr size_t first() const {
+    for (size_t w = 0; w < words.size(); w++) {
+      if (words[w] != 0) {
+        return w * 64 + static_cast<size_t>(std::countr_zero(words[w]));
+      }
+    }
+    return N;
+  }
+};
+
+} // namespace detail
+
+// What went wrong in a parse, see ErrorInfo
+enum class ErrorCode : std::uint8_t {
+  // Nothing more specific is known (ex: an ArgParse returned a bare error)
+  Unknown,
+  // The value of a flag could not be parsed
+  InvalidValue,
+  // A flag was the last arg, so it had no value
+  MissingValue,
+  // A positional could not be parsed
+  InvalidPositional,
+  // An arg (or config key) that is not one of our flags
+  UnknownArg,
+  // The first arg is not one of our subcommands
+  UnknownCommand,
+  // A response file or config file could not be read
+  UnreadableFile,
+  // Response files referred to each other too deeply
+  ResponseFileDepth,
+  // An arg read from a stream did not fit in its buffer
+  ArgTooLong,
+  // A flag with disallow_multiflag was given more than once
+  DuplicateFlag,
+  // A member with required was not given (see ErrorInfo::missing)
+  MissingRequired,
+  // A line of a config file that is not a key = value pair
+  BadConfigLine,
+  // One of the help args was given, and help was printed
+  Help,
+  // A shell completion request was answered
+  Completion,
+  // The args ran out before all of our positionals were given
+  MissingPositional,
+  // T itself cannot be parsed into (ex: an Options member whose name does not
+  // start with MetaInfo<T>::OptionsPrefix, or a second variadic positional).
+  // member is the member at fault.
+  BadSchema,
+};
+
+// Where and why a parse failed. Filling this in only ever copies a few words,
+// and a message is only built from it if one is asked for (see FormatError).
+struct ErrorInfo {
+  ErrorCode code = ErrorCode::Unknown;
+  // The index in argv of the arg we failed at (or of the @path of the response
+  // file it is in), or -1 if it did not come from argv (ex: the environment)
+  int arg_index = -1;
+  // The index in T of the member we failed at, or -1 if there is none
+  int member = -1;
+  // For errors in a config file, the line (from 1) they are on, otherwise 0
+  unsigned line = 0;
+  // For MissingRequired, the members that were required but not given, and how
+  // many of them there are. member is the first of them.
+  detail::MemberSet<CLAPP_MAX_MEMBERS> missing{};
+  unsigned missing_count = 0;
+  // The value or path we failed at, if there is one. Points into whatever it
+  // was read from (argv, a mapped file, or the environment).
+  const char *value = nullptr;
+};
+
+// If we failed to convert into a type. ArgParse specializations only need to
+// return a ParseError{}, the parse fills in where it happened.
+struct ParseError : ErrorInfo {};
 
 template <class T> using ArgParseReturnT = std::variant<T, ParseError>;
 
@@ -36,11 +160,24 @@ concept is_parsable =
       } -> std::convertible_to<ArgParseReturnT<T>>;
     };
 
+// ArgParse<T>::ParseInto(member, begin, end) is an optional way to parse args
+// into a member that is already there, rather than replacing it, for members
+// that take any number of args (ex: Sink). It returns a ParseError, or nothing
+// on success. A positional whose ArgParse has one is variadic: it takes every
+// positional arg after the others, each with its own call to ParseInto.
+template <class T>
+concept has_parse_into =
+    requires(T &member, const char **&begin, const char *const *const end) {
+      {
+        ArgParse<T>::ParseInto(member, begin, end)
+      } -> std::convertible_to<std::optional<ParseError>>;
+    };
+
 // If we called with --help or are missing positional arguments
-struct UsageError {};
+struct UsageError : ErrorInfo {};
 
 // Represents an unknown argument or flag that cannot be parsed
-struct UnknownArgError {};
+struct UnknownArgError : ErrorInfo {};
 
 // Need to handle at compile time:
 /*
@@ -81,14 +218,21 @@ AND
 // 2. just have a normal type that we fill out and use, that just has the
 // members listed that can be set
 struct Options {
-  // The name to override the member name with
-  std::string name;
-  // To disallow multiflag support
+  // The name to override the member name with. This is a view so that
+  // constructing and copying Options never allocates, so it should refer to
+  // something that outlives parsing (typically a string literal)
+  std::string_view name;
+  // To make giving the flag more than once an error (rather than the last one
+  // winning)
   bool disallow_multiflag;
-  // TODO: To state that a flag is required
+  // To make the parse fail unless the member is given, by a flag or from a
+  // config file or the environment
   bool required;
   // If an argument is positional and not a flag
   bool positional;
+  // The environment variable to read this member from when it is not given as
+  // a flag. Overrides the name derived from MetaInfo<T>::env_prefix.
+  std::string_view env;
 };
 
 // The metainfo for a given type to be parsed. Has sane defaults but can be
@@ -97,126 +241,188 @@ template <class T> struct MetaInfo {
   constexpr static std::string_view OptionsPrefix = "__";
   constexpr static std::array help_args{"--help", "--h"};
   constexpr static bool extra_args_ok = true;
+  // Expand @path args into the args held in the file at path (see
+  // MappedFiles)
+  constexpr static bool response_files = false;
+  // If not empty, every flag falls back to the environment variable named
+  // env_prefix + its member name in upper case (ex: APP_PORT for port) when
+  // it is not given. See also Options::env.
+  constexpr static std::string_view env_prefix = "";
+  // If not empty, a first arg equal to this (ex: "--clapp-complete") asks for
+  // shell completions of the args after it instead of a parse (see complete)
+  constexpr static std::string_view complete_arg = "";
+  // A type to report what each parse did to (see ParseStats and TraceEvent),
+  // or void to compile all of that out
+  using instrumentation = void;
 };
 
-namespace detail {
-
-template <class T, class U> struct Combine {
-  using first = T;
-  using second = U;
+// Keeps the files a parse reads (response files and config files) mapped for
+// as long as anything parsed from them (ex: std::string_view members) is in
+// use. Parses that are not given one keep their files mapped for the rest of
+// the program, just like argv.
+struct MappedFiles {
+  MappedFiles() = default;
+  // Keep the list of mappings in resource (the mappings themselves are never
+  // allocated)
+  explicit MappedFiles(std::pmr::memory_resource *resource) : files(resource) {}
+
+  std::pmr::vector<detail::MappedFile> files;
 };
 
-template <class... TArgs> struct RetTrait {
-  using type = std::array<const char *, sizeof...(TArgs)>;
-};
+namespace detail {
 
-template <class T> struct MemberRef {
-  MemberRef(T &t_ref, const char *name) : field_ref(t_ref), name(name) {}
+// The memory resource given to the parse running on this thread, if any
+inline thread_local std::pmr::memory_resource *parse_resource = nullptr;
 
-  T &field_ref;
-  std::string_view name;
+// Gives the parses on this thread resource for as long as it is in scope
+class ResourceScope {
+public:
+  explicit ResourceScope(std::pmr::memory_resource *resource)
+      : previous(std::exchange(parse_resource, resource)) {}
+  ~ResourceScope() { parse_resource = previous; }
+  ResourceScope(ResourceScope const &) = delete;
+  ResourceScope &operator=(ResourceScope const &) = delete;
+
+private:
+  std::pmr::memory_resource *previous;
 };
 
-template <size_t I, size_t... Is>
-auto make_member_refs(auto const &member_names, auto &...bindings) {
-  if constexpr (sizeof...(Is) != 0) {
-    return std::tuple_cat(
-        std::make_tuple(MemberRef(std::get<I>(std::tie(bindings...)),
-                                  std::get<I>(member_names))),
-        make_member_refs<Is...>(member_names, bindings...));
-  } else {
-    return std::make_tuple(MemberRef(std::get<I>(std::tie(bindings...)),
-                                     std::get<I>(member_names)));
-  }
-}
+} // namespace detail
 
-template <size_t... Is>
-auto make_member_refs_wrap(auto const &member_names, std::index_sequence<Is...>,
-                           auto &...bindings) {
-  return make_member_refs<Is...>(member_names, bindings...);
+// The memory resource an ArgParse should allocate its value from: the one
+// given to the parse running on this thread (see ParseArgs), or the default
+// resource. std::pmr::string and std::pmr::vector members in clapp/types.hpp
+// are allocated from it.
+inline std::pmr::memory_resource *ParseResource() {
+  return detail::parse_resource != nullptr ? detail::parse_resource
+                                           : std::pmr::get_default_resource();
 }
 
-template <class T, class F>
-decltype(auto) dump_type(T &&val, F &&f, auto &...bindings) {
-  typename RetTrait<decltype(bindings)...>::type member_names{};
-  auto itr = member_names.begin();
-  // TODO: Do this logic at compile time
-  auto lamb = [&itr](auto &&, auto &&...args) {
-    if constexpr (sizeof...(args) >= 3) {
-      auto tup = std::make_tuple(args...);
-      if (std::get<0>(tup) == "  ") {
-        // Then this is a TOP LEVEL member!
-        // Name is: std::get<1>(tup)
-        *itr++ = std::get<2>(tup);
-      }
-    }
+// What a single parse did, reported to MetaInfo<T>::instrumentation::on_stats
+// at the end of every parse
+struct ParseStats {
+  // How many args we classified (args consumed as flag values are not
+  // examined on their own)
+  size_t tokens = 0;
+  // How many times we tried to parse a value into a member, from any source
+  size_t member_parses = 0;
+  // How many of the args were flags we found in the flag table
+  size_t flag_hits = 0;
+  // How long we spent in ArgParse<T>::Parse in total
+  std::chrono::nanoseconds parse_time{};
+  // How long the whole parse took
+  std::chrono::nanoseconds total_time{};
+  // How many allocations the parse made, if the instrumentation can count them
+  // (with a static size_t allocations()), otherwise 0
+  size_t allocations = 0;
+};
+
+// Something that happened during a parse, reported to
+// MetaInfo<T>::instrumentation::on_event as it happens
+struct TraceEvent {
+  enum class Kind {
+    // We classified arg. member is the member it is a flag for, if it is one
+    Token,
+    // We ran the ArgParse for member, starting at arg (which is null if there
+    // was no arg left to give it)
+    MemberParse,
   };
-  __builtin_dump_struct(&val, lamb);
-  auto tuple = make_member_refs_wrap(
-      member_names, std::make_index_sequence<sizeof...(bindings)>{},
-      bindings...);
-  // Now combine our member names with our binding references into MemberRef
-  // instances
-  std::forward<F>(f)(std::move(tuple));
-}
-
-template <class... Ts> struct OverloadSet : Ts... {
-  constexpr OverloadSet(Ts &&...ts) : Ts(std::move(ts))... {}
-  using Ts::operator()...;
-  constexpr static auto size = sizeof...(Ts);
+  Kind kind;
+  const char *arg;
+  std::string_view member;
+  // For MemberParse, how long the ArgParse took and whether it succeeded
+  std::chrono::nanoseconds duration{};
+  bool ok = true;
 };
 
-template <class... Ts> constexpr auto MakeOverloadedSet(Ts &&...ts) {
-  return OverloadSet<Ts...>(std::forward<Ts>(ts)...);
-}
+namespace detail {
 
-constexpr int CountOccurances(const char *str, char c) {
-  return *str == '\0' ? 0 : (*str == c) + CountOccurances(str + 1, c);
-}
+// Settings that were added to MetaInfo later are optional in specializations
+template <class T> constexpr bool response_files_enabled = [] {
+  if constexpr (requires { MetaInfo<T>::response_files; }) {
+    return static_cast<bool>(MetaInfo<T>::response_files);
+  } else {
+    return false;
+  }
+}();
+
+template <class T> constexpr std::string_view env_prefix = [] {
+  if constexpr (requires { MetaInfo<T>::env_prefix; }) {
+    return std::string_view(MetaInfo<T>::env_prefix);
+  } else {
+    return std::string_view();
+  }
+}();
+
+// The hidden arg that asks for shell completions instead of a parse (see
+// complete), or empty to never complete
+template <class T> constexpr std::string_view complete_arg = [] {
+  if constexpr (requires { MetaInfo<T>::complete_arg; }) {
+    return std::string_view(MetaInfo<T>::complete_arg);
+  } else {
+    return std::string_view();
+  }
+}();
 
-// We count our arguments by counting how many ) there are
-// since we will always use (_1)(_2) ... (_N) for our values
-#define NUMARGS(...) (detail::CountOccurances(#__VA_ARGS__, ')'))
+// The name a subcommand is selected by (see Subcommands)
+template <class T> constexpr std::string_view command_name = [] {
+  static_assert(requires { MetaInfo<T>::command_name; },
+                "Subcommands must have a MetaInfo<T>::command_name!");
+  return std::string_view(MetaInfo<T>::command_name);
+}();
 
-// IMPORTED HEADER
+template <class T> struct instrumentation_of {
+  using type = void;
+};
+template <class T>
+  requires requires { typename MetaInfo<T>::instrumentation; }
+struct instrumentation_of<T> {
+  using type = typename MetaInfo<T>::instrumentation;
+};
+template <class T>
+using instrumentation_type = typename instrumentation_of<T>::type;
+template <class T>
+constexpr bool instrumented = !std::is_void_v<instrumentation_type<T>>;
 
-// Decltype-ify and comma-ify our large macros for expansion
-#define DECLTYPE_BODY(n, d, ...) d(decltype(__VA_ARGS__))
-#define DECLTYPE_ADD_REF_BODY(n, d, ...)                                       \
-  d(std::add_lvalue_reference_t<decltype(__VA_ARGS__)>)
-#define DECLVAL_BODY(n, d, ...) d(std::declval<decltype(__VA_ARGS__)>())
-#define IDENTITY_BODY(n, d, ...) d(__VA_ARGS__)
+// How deep response files may refer to other response files
+constexpr int max_response_file_depth = 16;
 
-#define IDENTITY(...) __VA_ARGS__
-#define STEP_CALLER(...) , __VA_ARGS__
+template <class T, class U> struct Combine {
+  using first = T;
+  using second = U;
+};
 
-#define COMMA ,
-#define COMMA_STEP(n, d, ...) STEP_CALLER
+// Converts to anything, so that T{AnyMember{}...} tells us whether T has at
+// least that many members
+struct AnyMember {
+  template <class U> operator U() const;
+};
 
-#define DECLTYPEIFY(...)                                                       \
-  SF_FOR_EACH(DECLTYPE_BODY, COMMA_STEP, SF_NULL, IDENTITY, __VA_ARGS__)
-#define DECLTYPEIFY_ADD_REF(...)                                               \
-  SF_FOR_EACH(DECLTYPE_ADD_REF_BODY, COMMA_STEP, SF_NULL, IDENTITY, __VA_ARGS__)
-#define DECLVALIFY(...)                                                        \
-  SF_FOR_EACH(DECLVAL_BODY, COMMA_STEP, SF_NULL, IDENTITY, __VA_ARGS__)
-#define NAMES(...)                                                             \
-  SF_FOR_EACH(IDENTITY_BODY, COMMA_STEP, SF_NULL, IDENTITY, __VA_ARGS__)
+template <class T, size_t... Is>
+constexpr bool is_initializable_from(std::index_sequence<Is...>) {
+  return requires { T{(void(Is), AnyMember{})...}; };
+}
 
-#define UNPACK_IMPL(...)                                                       \
-  [](auto &&t, auto &&f) -> decltype(({                                        \
-    auto &&[NAMES(__VA_ARGS__)] = std::forward<decltype(t)>(t);                \
-    (void)(std::tie(NAMES(__VA_ARGS__)));                                      \
-    std::declval<void>();                                                      \
-  })) {                                                                        \
-    auto &&[NAMES(__VA_ARGS__)] = std::forward<decltype(t)>(t);                \
-    dump_type(std::forward<decltype(t)>(t), std::forward<decltype(f)>(f),      \
-              NAMES(__VA_ARGS__));                                             \
+// An aggregate can be initialized from any number of values up to its member
+// count, and from none past it. So we binary search for the largest count that
+// works, which only needs log2(CLAPP_MAX_MEMBERS) probes rather than trying
+// every count in turn.
+template <class T, size_t Lo, size_t Hi> constexpr size_t count_members() {
+  if constexpr (Lo == Hi) {
+    return Lo;
+  } else {
+    constexpr size_t mid = (Lo + Hi + 1) / 2;
+    if constexpr (is_initializable_from<T>(std::make_index_sequence<mid>{})) {
+      return count_members<T, mid, Hi>();
+    } else {
+      return count_members<T, Lo, mid - 1>();
+    }
   }
+}
 
-template <class T, class V, class F>
-concept is_unpackable = requires(T &&t, V &&v, F &&f) {
-  { t(std::forward<V>(v), std::forward<F>(f)) };
-};
+// The number of members of T, or CLAPP_MAX_MEMBERS + 1 if it has too many
+template <class T>
+constexpr size_t member_count = count_members<T, 0, CLAPP_MAX_MEMBERS + 1>();
 
 // Helper to report errors for unpacking
 template <class T, bool err, auto sz> struct UnpackableWrapperError {
@@ -224,92 +430,175 @@ template <class T, bool err, auto sz> struct UnpackableWrapperError {
   constexpr static auto size = sz;
 };
 
-template <class T, class F> auto const &do_on_bindings_impl(T &&t, F &&f) {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wgnu-statement-expression-from-macro-expansion"
-  // clang-format off
-  constexpr static auto set = MakeOverloadedSet(
-UNPACK_IMPL((_0)),
-UNPACK_IMPL((_0)(_1)),
-UNPACK_IMPL((_0)(_1)(_2)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)(_57)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)(_57)(_58)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)(_57)(_58)(_59)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)(_57)(_58)(_59)(_60)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)(_57)(_58)(_59)(_60)(_61)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)(_57)(_58)(_59)(_60)(_61)(_62)),
-UNPACK_IMPL((_0)(_1)(_2)(_3)(_4)(_5)(_6)(_7)(_8)(_9)(_10)(_11)(_12)(_13)(_14)(_15)(_16)(_17)(_18)(_19)(_20)(_21)(_22)(_23)(_24)(_25)(_26)(_27)(_28)(_29)(_30)(_31)(_32)(_33)(_34)(_35)(_36)(_37)(_38)(_39)(_40)(_41)(_42)(_43)(_44)(_45)(_46)(_47)(_48)(_49)(_50)(_51)(_52)(_53)(_54)(_55)(_56)(_57)(_58)(_59)(_60)(_61)(_62)(_63))
-  );
-  // clang-format on
-#pragma GCC diagnostic pop
-  constexpr static bool unpackable = is_unpackable<decltype(set), T, F>;
-  // We return solely for type deduction purposes so that we get better error
-  // reporting
-  if constexpr (unpackable) {
-    set(std::forward<T>(t), std::forward<F>(f));
-  }
-  return set;
+// Returns a tuple of references to each of the members of t, in declaration
+// order
+template <class T> constexpr auto tie_members(T &t) {
+  constexpr auto count = member_count<std::remove_const_t<T>>;
+  using unpackable_error_type =
+      UnpackableWrapperError<T, count <= CLAPP_MAX_MEMBERS, CLAPP_MAX_MEMBERS>;
+  static_assert(unpackable_error_type::value,
+                "Must have fewer members to be unpackable!");
+  if constexpr (unpackable_error_type::value) {
+    return Binder<count>::tie(t);
+  }
+}
+
+// A member that is a plain struct of other members (with no ArgParse of its
+// own) is a group: its members are flattened into the struct it is in, and are
+// given as --group.member
+template <class M>
+concept is_group = std::is_class_v<M> && std::is_aggregate_v<M> &&
+                   !std::is_convertible_v<M &, Options> && !is_parsable<M> &&
+                   !has_parse_into<M> &&
+                   !requires { std::tuple_size<M>::value; };
+
+template <class T>
+using members_type = decltype(tie_members(std::declval<T &>()));
+
+template <class T>
+constexpr bool has_groups =
+    []<class... Ms>(std::type_identity<std::tuple<Ms...>>) {
+      return (is_group<std::remove_cvref_t<Ms>> || ...);
+    }(std::type_identity<members_type<T>>{});
+
+// Returns a tuple of references to each of the leaf members of t, in
+// declaration order: its own members, with the members of each of its groups
+// (recursively) in place of the group
+template <class T> constexpr auto tie_leaves(T &t) {
+  if constexpr (!has_groups<T>) {
+    return tie_members(t);
+  } else {
+    return std::apply(
+        [](auto &...members) {
+          return std::tuple_cat([](auto &member) {
+            if constexpr (is_group<std::remove_cvref_t<decltype(member)>>) {
+              return tie_leaves(member);
+            } else {
+              return std::tie(member);
+            }
+          }(members)...);
+        },
+        tie_members(t));
+  }
+}
+
+// One of the members of T (or of its groups), in the order that
+// __builtin_dump_struct visits them
+struct MemberNode {
+  // 1 for the members of T, 2 for the members of a group in T, and so on
+  size_t depth;
+  bool group;
 };
 
-#undef NUMARGS
-#undef UNPACK_IMPL
+// How many members T has, counting the members of its groups (and the groups)
+template <class T>
+constexpr size_t node_count =
+    []<class... Ms>(std::type_identity<std::tuple<Ms...>>) {
+      return (size_t{0} + ... + [] {
+        using member_type = std::remove_cvref_t<Ms>;
+        if constexpr (is_group<member_type>) {
+          return 1 + node_count<member_type>;
+        } else {
+          return size_t{1};
+        }
+      }());
+    }(std::type_identity<members_type<T>>{});
+
+template <class T>
+constexpr void add_member_nodes(MemberNode *&out, size_t depth) {
+  [&]<class... Ms>(std::type_identity<std::tuple<Ms...>>) {
+    (
+        [&] {
+          using member_type = std::remove_cvref_t<Ms>;
+          *out++ = {depth, is_group<member_type>};
+          if constexpr (is_group<member_type>) {
+            add_member_nodes<member_type>(out, depth + 1);
+          }
+        }(),
+        ...);
+  }(std::type_identity<members_type<T>>{});
+}
 
-template <class T, class F> constexpr auto const &do_on_bindings(T &t, F &&f) {
-  return do_on_bindings_impl(t, std::forward<F>(f));
+// Every member of T (and of its groups), worked out from the types alone
+template <class T>
+constexpr auto member_nodes = [] {
+  std::array<MemberNode, node_count<T>> nodes{};
+  MemberNode *out = nodes.data();
+  add_member_nodes<T>(out, 1);
+  return nodes;
+}();
+
+// The longest group.member name we will spell out for a member of a group
+constexpr size_t max_member_name_size = 128;
+
+// How many of the leaf members of T are in a group, and so need their dotted
+// names spelled out
+template <class T>
+constexpr size_t grouped_leaf_count = [] {
+  size_t count = 0;
+  for (auto const &node : member_nodes<T>) {
+    count += node.depth > 1 && !node.group ? 1 : 0;
+  }
+  return count;
+}();
+
+// Walk the struct once with __builtin_dump_struct and collect the names (and
+// the spelling of the types) of all of the leaf members, in declaration order.
+// Members of groups are named group.member, which is written into storage.
+template <class T, size_t N>
+constexpr void dump_members(T &val,
+                            std::array<std::string_view, N> &member_names,
+                            std::array<std::string_view, N> &member_types,
+                            std::span<char> storage) {
+  constexpr auto const &nodes = member_nodes<T>;
+  // The names of the groups we are in, by depth
+  std::array<std::string_view, nodes.size() + 1> path{};
+  size_t node = 0;
+  size_t idx = 0;
+  char *storage_pos = storage.data();
+  auto lamb = [&](auto &&, auto &&...args) {
+    if constexpr (sizeof...(args) >= 3) {
+      auto tup = std::forward_as_tuple(args...);
+      using indent_type = decltype(std::get<0>(tup));
+      if constexpr (std::is_convertible_v<indent_type, std::string_view>) {
+        // Members are indented two spaces per level. Anything deeper than the
+        // member we expect next is inside a member that is not a group (ex:
+        // the fields of a std::string_view), which we skip.
+        std::string_view const indent(std::get<0>(tup));
+        if (node == nodes.size() || indent.size() != 2 * nodes[node].depth) {
+          return;
+        }
+        auto const [depth, group] = nodes[node++];
+        std::string_view const name(std::get<2>(tup));
+        if (group) {
+          path[depth] = name;
+          return;
+        }
+        assert(idx < N);
+        member_types[idx] = std::get<1>(tup);
+        if (depth == 1) {
+          member_names[idx++] = name;
+          return;
+        }
+        // Spell out group.member, with every group we are in
+        char *const begin = storage_pos;
+        size_t size = name.size();
+        for (size_t d = 1; d < depth; d++) {
+          size += path[d].size() + 1;
+        }
+        assert(size <= max_member_name_size);
+        for (size_t d = 1; d < depth && size <= max_member_name_size; d++) {
+          storage_pos = std::copy(path[d].begin(), path[d].end(), storage_pos);
+          *storage_pos++ = '.';
+        }
+        if (size <= max_member_name_size) {
+          storage_pos = std::copy(name.begin(), name.end(), storage_pos);
+        }
+        member_names[idx++] = std::string_view(begin, storage_pos - begin);
+      }
+    }
+  };
+  __builtin_dump_struct(&val, lamb);
 }
 
 // Because things like std::vector exist
@@ -323,97 +612,522 @@ template <class T, class F> constexpr auto const &do_on_bindings(T &t, F &&f) {
 // Special case for --help: don't let that be overriden
 // If we see any argv that is --help, we stop and print our help message
 
-// Return a map of names to Options
-template <class T, class U> decltype(auto) get_arg_options(U &&members_tuple) {
-  // TODO: Could be constexpr array?
-  // TODO: If we swap Options to use types, this will need to change to be a
-  // tuple
-  std::unordered_map<std::string_view, Options> map;
+// A resolved flag spelling. Flags that were not renamed are spelled "--" +
+// their member name, which we keep as two pieces so that we never have to build
+// the full string.
+struct FlagName {
+  std::string_view prefix;
+  std::string_view name;
+
+  constexpr size_t size() const { return prefix.size() + name.size(); }
+  constexpr char operator[](size_t i) const {
+    return i < prefix.size() ? prefix[i] : name[i - prefix.size()];
+  }
+
+  // Lexicographically compare our spelling against arg, as if we were a
+  // single string
+  constexpr int compare(std::string_view arg) const {
+    auto head = arg.substr(0, prefix.size());
+    if (int c = prefix.compare(head); c != 0) {
+      return c;
+    }
+    return name.compare(arg.substr(prefix.size()));
+  }
+  constexpr bool starts_with(std::string_view str) const {
+    if (size() < str.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < str.size(); i++) {
+      if ((*this)[i] != str[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Bytes are compared as unsigned, like std::string_view::compare, so that
+  // the table sorts the same way compare(arg) searches it
+  constexpr int compare(FlagName const &other) const {
+    auto const len = std::min(size(), other.size());
+    for (size_t i = 0; i < len; i++) {
+      if ((*this)[i] != other[i]) {
+        return std::char_traits<char>::lt((*this)[i], other[i]) ? -1 : 1;
+      }
+    }
+    return size() == other.size() ? 0 : (size() < other.size() ? -1 : 1);
+  }
+};
+
+// Maps a flag spelling to the index of the member it belongs to
+struct FlagEntry {
+  FlagName flag;
+  size_t index;
+};
+
+constexpr char to_upper(char c) {
+  return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// A resolved environment variable name. Names derived from a member are
+// spelled prefix + the member name in upper case, which (like FlagName) we
+// never build as a string.
+struct EnvName {
+  std::string_view prefix;
+  std::string_view name;
+  // Whether name is read as if it were upper case (with _ for .)
+  bool upper;
+
+  constexpr size_t size() const { return prefix.size() + name.size(); }
+  constexpr char operator[](size_t i) const {
+    if (i < prefix.size()) {
+      return prefix[i];
+    }
+    char const c = name[i - prefix.size()];
+    if (!upper) {
+      return c;
+    }
+    // The members of groups are read from PREFIX_GROUP_MEMBER
+    return c == '.' ? '_' : to_upper(c);
+  }
+
+  // Compare against a std::string_view or another EnvName, with bytes
+  // compared as unsigned (like FlagName)
+  template <class U> constexpr int compare(U const &other) const {
+    auto const len = std::min(size(), other.size());
+    for (size_t i = 0; i < len; i++) {
+      if ((*this)[i] != other[i]) {
+        return std::char_traits<char>::lt((*this)[i], other[i]) ? -1 : 1;
+      }
+    }
+    return size() == other.size() ? 0 : (size() < other.size() ? -1 : 1);
+  }
+};
+
+// Maps an environment variable to the index of the member it belongs to
+struct EnvEntry {
+  EnvName env;
+  size_t index;
+};
+
+// Everything we learn about T from reflection. This is built exactly once per
+// type (the first time we parse a T) and shared by every parse after that, so
+// parsing a command line never has to walk the struct again.
+// NOTE: The Options are read from the first instance we see, so they should be
+// default member initializers rather than something set per-instance.
+template <class T> struct Schema {
   using meta_type = MetaInfo<T>;
-  std::apply(
-      [&map](auto &...members) {
-        // For each member:
-        (
-            [&map](auto &memb) {
-              if constexpr (std::is_convertible_v<decltype(memb.field_ref),
-                                                  Options>) {
-                // If the name does not start with meta_type::OptionsPrefix, we
-                // abort safely
-                if (memb.name.starts_with(meta_type::OptionsPrefix)) {
-                  map.emplace(
-                      std::string_view(
-                          &memb.name.data()[meta_type::OptionsPrefix.size()]),
-                      memb.field_ref);
+  // Members of groups are flattened into T, so everything here is indexed by
+  // leaf member
+  using refs_type = decltype(tie_leaves(std::declval<T &>()));
+  constexpr static size_t size = std::tuple_size_v<refs_type>;
+  // The index we use in the flag table for the help args
+  constexpr static size_t help_index = size;
+  // The index find_flag returns when an arg is not a flag we know of
+  constexpr static size_t npos = size + 1;
+
+  // The names of each of our members, in declaration order
+  std::array<std::string_view, size> names{};
+  // The types of each of our members, as spelled in T
+  std::array<std::string_view, size> types{};
+  // The Options for each member (default constructed if it has none)
+  std::array<Options, size> options{};
+  // The member indices of our positionals, in the order they are consumed
+  std::array<size_t, size> positionals{};
+  // How many of our members are positional
+  int positionals_count = 0;
+  // The member index of our variadic positional (see has_parse_into), which
+  // takes every positional after the others, or npos
+  size_t variadic_positional = npos;
+  // The first member that makes T unparseable (see ErrorCode::BadSchema), or
+  // -1 if there is none. Every parse fails with it.
+  int bad_member = -1;
+  // Every flag spelling we accept (including the help args), sorted so that a
+  // token can be binary searched to the one member it belongs to
+  std::array<FlagEntry, size + meta_type::help_args.size()> flags{};
+  size_t flags_count = 0;
+  // Every environment variable a flag falls back to, sorted by name
+  std::array<EnvEntry, size> envs{};
+  size_t envs_count = 0;
+  // The members that have to be given (Options::required)
+  MemberSet<size> required{};
+  // The flags that may only be given once (Options::disallow_multiflag)
+  MemberSet<size> single{};
+  // The group.member names of the members of groups
+  std::array<char, grouped_leaf_count<T> * max_member_name_size>
+      name_storage{};
+
+  // Built in place (see get_schema), since flags points into options
+  constexpr explicit Schema(T &inst) {
+    dump_members(inst, names, types, std::span<char>(name_storage));
+    auto members = tie_leaves(inst);
+    // For each member:
+    // If the type matches, check the name
+    // If the name is prefixed with OPTIONS_PREFIX, attach it to the member
+    // (in the same group) with the rest of the name
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+      (
+          [&](auto &memb, std::string_view name) {
+            if constexpr (std::is_convertible_v<decltype(memb), Options>) {
+              auto const dot = name.rfind('.');
+              auto const group =
+                  name.substr(0, dot == name.npos ? 0 : dot + 1);
+              name.remove_prefix(group.size());
+              // If the name does not start with meta_type::OptionsPrefix, we
+              // abort safely
+              if (name.starts_with(meta_type::OptionsPrefix)) {
+                name.remove_prefix(meta_type::OptionsPrefix.size());
+                auto itr = std::find_if(
+                    names.begin(), names.end(), [&](std::string_view other) {
+                      return other.size() == group.size() + name.size() &&
+                             other.starts_with(group) &&
+                             other.ends_with(name);
+                    });
+                if (itr != names.end()) {
+                  options[itr - names.begin()] = memb;
+                }
+              } else if (bad_member < 0) {
+                bad_member = static_cast<int>(Is);
+              }
+            }
+          }(std::get<Is>(members), names[Is]),
+          ...);
+      // Options members are never flags or positionals themselves
+      (
+          [&](auto &memb) {
+            if constexpr (!std::is_convertible_v<decltype(memb), Options>) {
+              if (options[Is].positional) {
+                if constexpr (has_parse_into<
+                                  std::remove_cvref_t<decltype(memb)>>) {
+                  // Only one positional can take the rest of them
+                  if (variadic_positional == npos) {
+                    variadic_positional = Is;
+                  } else if (bad_member < 0) {
+                    bad_member = static_cast<int>(Is);
+                  }
                 } else {
-                  // TODO: Fail cleanly with good error message
-                  assert(false);
+                  positionals[positionals_count++] = Is;
                 }
+                return;
+              }
+              if (options[Is].required) {
+                required.set(Is);
               }
-            }(members),
-            ...);
-        // If the type matches, check the name
-        // If the name is prefixed with OPTIONS_PREFIX, add it to the map of
-        // names to be returned
-      },
-      members_tuple);
-  return map;
+              if (options[Is].disallow_multiflag) {
+                single.set(Is);
+              }
+              if (options[Is].name.empty()) {
+                // look for the resolved name (-- from flag, empty means not
+                // replaced)
+                flags[flags_count++] = {{"--", names[Is]}, Is};
+              } else {
+                flags[flags_count++] = {{"", options[Is].name}, Is};
+              }
+              if (!options[Is].env.empty()) {
+                envs[envs_count++] = {{"", options[Is].env, false}, Is};
+              } else if (!env_prefix<T>.empty()) {
+                envs[envs_count++] = {{env_prefix<T>, names[Is], true}, Is};
+              }
+            }
+          }(std::get<Is>(members)),
+          ...);
+    }(std::make_index_sequence<size>{});
+    // Special case for --help: don't let that be overriden
+    for (std::string_view help : meta_type::help_args) {
+      flags[flags_count++] = {{"", help}, help_index};
+    }
+    // Help entries have the largest index, so we sort them first among equal
+    // spellings for lower_bound to find
+    std::sort(flags.begin(), flags.begin() + flags_count,
+              [](FlagEntry const &lhs, FlagEntry const &rhs) {
+                auto c = lhs.flag.compare(rhs.flag);
+                return c != 0 ? c < 0 : lhs.index > rhs.index;
+              });
+    std::sort(envs.begin(), envs.begin() + envs_count,
+              [](EnvEntry const &lhs, EnvEntry const &rhs) {
+                return lhs.env.compare(rhs.env) < 0;
+              });
+  }
+  Schema(Schema const &) = delete;
+  Schema &operator=(Schema const &) = delete;
+
+  // Find the first flag (in sorted order) that starts with prefix. Every flag
+  // that does follows it.
+  constexpr auto find_flag_prefix(std::string_view prefix) const {
+    return std::lower_bound(flags.begin(), flags.begin() + flags_count, prefix,
+                            [](FlagEntry const &entry, std::string_view p) {
+                              return entry.flag.compare(p) < 0;
+                            });
+  }
+
+  // Find the member index that a flag spelled exactly as arg belongs to.
+  // Returns help_index for help args, and npos for anything else.
+  constexpr size_t find_flag(std::string_view arg) const {
+    auto const flags_end = flags.begin() + flags_count;
+    auto itr = std::lower_bound(flags.begin(), flags_end, arg,
+                                [](FlagEntry const &entry, std::string_view a) {
+                                  return entry.flag.compare(a) < 0;
+                                });
+    if (itr != flags_end && itr->flag.compare(arg) == 0) {
+      return itr->index;
+    }
+    return npos;
+  }
+
+  // The spelling of the flag for the member at index (which is not positional)
+  constexpr FlagName flag_name(size_t index) const {
+    return options[index].name.empty() ? FlagName{"--", names[index]}
+                                       : FlagName{"", options[index].name};
+  }
+
+  // Find the member index that reads the environment variable name, or npos
+  constexpr size_t find_env(std::string_view name) const {
+    auto const envs_end = envs.begin() + envs_count;
+    auto itr = std::lower_bound(envs.begin(), envs_end, name,
+                                [](EnvEntry const &entry, std::string_view n) {
+                                  return entry.env.compare(n) < 0;
+                                });
+    if (itr != envs_end && itr->env.compare(name) == 0) {
+      return itr->index;
+    }
+    return npos;
+  }
+};
+
+// Get the (lazily built, then cached) schema for T
+template <class T> Schema<T> const &get_schema(T &inst) {
+  static Schema<T> const schema(inst);
+  return schema;
 }
 
 // See if any of the args listed match the help args, return true if so
-template <class T> constexpr bool is_help(const char *arg) {
+template <class T> constexpr bool is_help(std::string_view arg) {
   using meta_type = MetaInfo<T>;
   return std::any_of(meta_type::help_args.begin(), meta_type::help_args.end(),
-                     [arg](const char *a) { return arg == a; });
+                     [arg](std::string_view a) { return arg == a; });
 }
 
-// We create our help message by walking our members and doing a few things:
-// 1. write our converted name (ex: a for positional --a for optional) (TODO:
-// Handle aliases?)
-// 2. write our type (ex: int, list, str, etc., grabbed from template
-// specialization)
-// 3. write our default (done by reading the current value when we do the parse,
-// also done by specialization)
+// Collects output in one buffer, so that all of it is written with a single
+// syscall when it is flushed. Anything that fits in the inline buffer (which
+// is any reasonable help message) does not allocate, and anything longer
+// moves to the heap rather than being written in pieces.
+class OutputBuffer {
+public:
+  explicit OutputBuffer(int fd = STDOUT_FILENO) : fd(fd) {}
+  OutputBuffer(OutputBuffer const &) = delete;
+  OutputBuffer &operator=(OutputBuffer const &) = delete;
+  ~OutputBuffer() { flush(); }
+
+  void append(std::string_view str) {
+    if (str.size() > capacity - size) {
+      grow(size + str.size());
+    }
+    std::copy_n(str.data(), str.size(), data + size);
+    size += str.size();
+    column += str.size();
+  }
+  void newline() {
+    append("\n");
+    column = 0;
+  }
+  // Append spaces up to the given column of the current line
+  void pad_to(size_t to) {
+    while (column < to) {
+      append(" ");
+    }
+  }
 
-// The usage line is given by argv[0] and all of our positional arguments
+  void flush() {
+    // Anything already printed through stdio has to come out first
+    fflush(stdout);
+    const char *pos = data;
+    while (size > 0) {
+      auto const written = ::write(fd, pos, size);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      pos += written;
+      size -= static_cast<size_t>(written);
+    }
+    size = 0;
+  }
 
-template <class T, class F>
-void on_positionals(T &member, auto const &options_map, F &&func) {
-  auto itr = options_map.find(member.name);
-  auto const options = itr != options_map.end() ? itr->second : Options{};
-  if (options.positional) {
-    func(member, options);
+private:
+  // Move to a heap buffer with room for at least needed chars
+  void grow(size_t needed) {
+    auto const new_capacity = std::max(needed, 2 * capacity);
+    auto bigger = std::make_unique_for_overwrite<char[]>(new_capacity);
+    std::copy_n(data, size, bigger.get());
+    heap = std::move(bigger);
+    data = heap.get();
+    capacity = new_capacity;
   }
-}
 
-template <class T> void display_help(T &inst, const char *program_name) {
-  // TODO: Display help message from members
-  // printf("HELP MESSAGE: %p: %s\n", static_cast<void *>(&inst), program_name);
-  // Get our options map: member name --> Option if it exists
-  std::unordered_map<std::string_view, Options> options_map;
-  do_on_bindings(inst, [&options_map](auto &&members) {
-    options_map = get_arg_options<T>(members);
-  });
-  printf("Usage: %s", program_name);
-  // Walk the members again, if they are positional, we write them out
-  // TODO: Or required flags
-  do_on_bindings(
-      inst, [&options_map = std::as_const(options_map)](auto &&members) {
-        std::apply(
-            [&options_map](auto &...members) {
-              (on_positionals(members, options_map,
-                              [](auto &member, auto const &options) {
-                                std::string name = options.name.empty()
-                                                       ? member.name.data()
-                                                       : options.name;
-                                printf(" <%s>", name.c_str());
-                              }),
-               ...);
-              // After all of the positionals are written, we write a newline
-              puts("");
-            },
-            members);
-      });
-  // Then, write our flags and the types of them, as well as any default values
+  int fd;
+  std::array<char, 8192> buf;
+  std::unique_ptr<char[]> heap;
+  char *data = buf.data();
+  size_t capacity = buf.size();
+  size_t size = 0;
+  size_t column = 0;
+};
+
+// ArgParse<T>::Format is an optional way to print a T (ex: a default value in
+// help), with the same interface as std::to_chars. Failing (with any errc)
+// means there is nothing worth printing.
+template <class T>
+concept has_format = requires(char *first, char *last, T const &value) {
+  {
+    ArgParse<T>::Format(first, last, value)
+  } -> std::same_as<std::to_chars_result>;
+};
+
+// The longest default value we print in help
+constexpr size_t max_default_size = 128;
+
+// We create our help message by walking our members:
+// 1. the usage line, which is given by argv[0] (after the program name, for a
+// subcommand) and all of our positional arguments
+// 2. each positional, with its type
+// 3. each flag as it is spelled (ex: --a, or its Options::name), with its type
+// and its default (the value it has when help is asked for)
+// 4. the help args
+// Everything goes into one OutputBuffer, so nothing allocates unless the help
+// is longer than its inline buffer.
+template <class T>
+void display_help(Schema<T> const &schema, T &inst, const char *program_name,
+                  const char *parent_program) {
+  using meta_type = MetaInfo<T>;
+  OutputBuffer out;
+  auto const append_flag = [&out](FlagName const &flag) {
+    out.append(flag.prefix);
+    out.append(flag.name);
+  };
+  auto const positional_name = [&schema](size_t i) {
+    return schema.options[i].name.empty() ? schema.names[i]
+                                          : schema.options[i].name;
+  };
+  constexpr std::string_view help_text = "Show this help";
+
+  out.append("Usage: ");
+  if (parent_program != nullptr) {
+    out.append(parent_program);
+    out.append(" ");
+  }
+  out.append(program_name);
+  // Everything but the help args is one of our flags
+  bool const has_flags =
+      schema.flags_count > meta_type::help_args.size();
+  if (has_flags) {
+    out.append(" [options]");
+  }
+  for (int p = 0; p < schema.positionals_count; p++) {
+    out.append(" <");
+    out.append(positional_name(schema.positionals[p]));
+    out.append(">");
+  }
+  bool const has_variadic = schema.variadic_positional != schema.npos;
+  if (has_variadic) {
+    out.append(" [<");
+    out.append(positional_name(schema.variadic_positional));
+    out.append(">...]");
+  }
+  out.newline();
+
+  // Line up the descriptions of everything we list in one column
+  size_t width = 0;
+  for (int p = 0; p < schema.positionals_count; p++) {
+    width = std::max(width, positional_name(schema.positionals[p]).size() + 2);
+  }
+  if (has_variadic) {
+    width = std::max(
+        width, positional_name(schema.variadic_positional).size() + 5);
+  }
+  for (size_t f = 0; f < schema.flags_count; f++) {
+    auto const &entry = schema.flags[f];
+    if (entry.index != schema.help_index) {
+      width = std::max(width, entry.flag.size() + 3 +
+                                  schema.types[entry.index].size());
+    }
+  }
+  size_t help_width = 0;
+  for (std::string_view help : meta_type::help_args) {
+    help_width += help.size() + 2;
+  }
+  width = std::max(width, help_width - 2);
+  auto const description_column = 2 + width + 2;
+
+  if (schema.positionals_count > 0 || has_variadic) {
+    out.newline();
+    out.append("Arguments:");
+    out.newline();
+    for (int p = 0; p < schema.positionals_count; p++) {
+      auto const i = schema.positionals[p];
+      out.append("  <");
+      out.append(positional_name(i));
+      out.append(">");
+      out.pad_to(description_column);
+      out.append(schema.types[i]);
+      out.newline();
+    }
+    if (has_variadic) {
+      auto const i = schema.variadic_positional;
+      out.append("  <");
+      out.append(positional_name(i));
+      out.append(">...");
+      out.pad_to(description_column);
+      out.append(schema.types[i]);
+      out.newline();
+    }
+  }
+
+  out.newline();
+  out.append("Options:");
+  out.newline();
+  // Flags are listed in declaration order, with whatever default they have
+  auto members = tie_leaves(inst);
+  [&]<size_t... Is>(std::index_sequence<Is...>) {
+    (
+        [&](auto &memb) {
+          using member_type = std::remove_cvref_t<decltype(memb)>;
+          if constexpr (!std::is_convertible_v<member_type &, Options>) {
+            if (schema.options[Is].positional) {
+              return;
+            }
+            out.append("  ");
+            append_flag(schema.flag_name(Is));
+            out.append(" <");
+            out.append(schema.types[Is]);
+            out.append(">");
+            if constexpr (has_format<member_type>) {
+              std::array<char, max_default_size> buf;
+              auto const [ptr, ec] = ArgParse<member_type>::Format(
+                  buf.data(), buf.data() + buf.size(), memb);
+              if (ec == std::errc{}) {
+                out.pad_to(description_column);
+                out.append("(default: ");
+                out.append(std::string_view(buf.data(), ptr - buf.data()));
+                out.append(")");
+              }
+            }
+            out.newline();
+          }
+        }(std::get<Is>(members)),
+        ...);
+  }(std::make_index_sequence<Schema<T>::size>{});
+  out.append("  ");
+  bool first = true;
+  for (std::string_view help : meta_type::help_args) {
+    if (!first) {
+      out.append(", ");
+    }
+    first = false;
+    out.append(help);
+  }
+  out.pad_to(description_column);
+  out.append(help_text);
+  out.newline();
 }
 
 // Example:
@@ -442,16 +1156,10 @@ struct Test {
 // unable to do anything with that argument: we will complain later depending on
 // meta_type
 
-// Returned to describe that a member was already satisfied, or was just
-// satisfied (ex, positionals)
+// Returned to describe that a member was just satisfied
 struct Satisfied {};
 
-// Helper types for disambiguating between flag and positional parse errors
-struct PositionalParseError : ParseError {};
-struct FlagParseError : ParseError {};
-
-using parse_member_ref_return_type =
-    std::variant<Satisfied, UsageError, PositionalParseError, FlagParseError>;
+using parse_member_ref_return_type = std::variant<Satisfied, ParseError>;
 
 // Determine the valid return types from MetaInfo<T> from a call to ParseArgs
 template <class T>
@@ -459,230 +1167,1446 @@ using parse_args_return_type = std::conditional_t<
     MetaInfo<T>::extra_args_ok, std::variant<T, UsageError, ParseError>,
     std::variant<T, UsageError, ParseError, UnknownArgError>>;
 
-template <class T>
-  requires(is_parsable<std::remove_reference_t<decltype(T::field_ref)>> ||
-           std::is_convertible_v<decltype(T::field_ref), Options>)
-parse_member_ref_return_type
-try_parse_member_ref(T &member_ref, auto const &options_map,
-                     int &positional_count, int &current_pos_index, auto &begin,
-                     auto const end) {
-  if constexpr (std::is_convertible_v<decltype(member_ref.field_ref),
-                                      Options>) {
+// Members that hold a std::pmr::polymorphic_allocator, which takes its memory
+// resource from whatever they were constructed with
+template <class M>
+concept uses_parse_resource =
+    std::uses_allocator_v<M, std::pmr::polymorphic_allocator<>>;
+
+// Parse the member at index I of inst from the args starting at begin (the
+// value of a flag, or a positional). On success, begin is moved past whatever
+// the ArgParse consumed.
+template <class T, size_t I, class It>
+constexpr parse_member_ref_return_type try_parse_member_ref(T &inst, It &begin,
+                                                            It const end) {
+  auto &field_ref = std::get<I>(tie_leaves(inst));
+  using field_type = std::remove_reference_t<decltype(field_ref)>;
+  if constexpr (std::is_convertible_v<field_type &, Options>) {
     // Do nothing.
-    // Don't consume any arguments
-    // Don't return an error
-    // Silently pass without touching the member_ref.field_ref
+    // Options members are never flags or positionals, so nothing dispatches to
+    // them
+    return Satisfied{};
+  } else if constexpr (has_parse_into<field_type>) {
+    auto local_begin = begin;
+    if (auto err = ArgParse<field_type>::ParseInto(field_ref, local_begin,
+                                                   end)) {
+      return *err;
+    }
+    begin = local_begin;
     return Satisfied{};
   } else {
     // TODO: We could consider silently skipping members that don't have a
     // conversion
     static_assert(
-        is_parsable<std::remove_reference_t<decltype(member_ref.field_ref)>>,
+        is_parsable<field_type>,
         "Can only parse members that are of types that we know how to convert! "
         "Consider specializing ArgParse!");
-    using parse_type =
-        ArgParse<std::remove_reference_t<decltype(member_ref.field_ref)>>;
-
-    // Check to see if we have Options available for this member
-    auto itr = options_map.find(member_ref.name);
-    auto const options = itr != options_map.end() ? itr->second : Options{};
-    // Check to see if we should be positional or a flag
-    if (options.positional) {
-      // If we are a positional flag, we are REQUIRED!
-      // If the positional we are trying to decode is not the same index as this
-      // one, we were satisfied earlier Every time we see a positional flag, we
-      // increment our index
-      if (current_pos_index++ < positional_count) {
-        return Satisfied{};
-      } else if (begin == end) {
-        // If we reached the end of our arguments but we weren't satisfied, we
-        // should report an error
-        // TODO: Error for missing positionals (expected current_pos_index + 1
-        // but have positional_count)
-        return UsageError{};
-      }
-      // Try to parse this member as a positional
-      auto local_begin = begin;
-      auto parse_result = parse_type::Parse(local_begin, end);
-      if (parse_result.index() >= 1) {
-        // TODO: return errors better than this
-        return PositionalParseError(std::get<1>(parse_result));
-      }
-      // Otherwise, we decoded the positional!
-      // Write the reference
-      member_ref.field_ref = std::get<0>(parse_result);
-      // Then move past what we consumed and increment our number of decoded
-      // positionals
-      begin = local_begin;
-      positional_count++;
-      return Satisfied{};
+    // We want to mutate a local begin, so that on error we don't move
+    auto local_begin = begin;
+    auto parse_result = ArgParse<field_type>::Parse(local_begin, end);
+    if (parse_result.index() >= 1) {
+      // TODO: return errors better than this
+      return std::get<1>(parse_result);
+    }
+    // T is always slot 0 of the parse result
+    if constexpr (uses_parse_resource<field_type>) {
+      // Assigning would copy the value into the member's own memory resource,
+      // so take over the value (and its resource) instead
+      std::destroy_at(&field_ref);
+      std::construct_at(&field_ref, std::get<0>(std::move(parse_result)));
     } else {
-      if (begin == end) {
-        // If we are at the end, all of the flags that we have seen are
-        // satisfied EXCEPT required flags we have not yet seen! Cannot just
-        // count (since multiflags exist)
-        // TODO ^
-        return Satisfied{};
-      }
-
-      std::string_view argstr(*begin);
-      // Handle a flag
-      // look for the resolved name (-- from flag, empty means not replaced)
-      std::string search_name = options.name.empty()
-                                    ? std::string("--") + member_ref.name.data()
-                                    : options.name;
-      if (search_name == argstr) {
-        // The flag we are looking for matches! Lets try to parse it now, and
-        // assign it to the ref We want to mutate a local begin, so that on
-        // error we can try other types before giving up
-        // TODO: We need to NOT use begin here, but rather begin + 1
-        // (or if there is an = in argstr, split on that and use the rhs + the
-        // begin + 1)
-        auto local_begin = begin + 1;
-        auto parse_result = parse_type::Parse(local_begin, end);
-        if (parse_result.index() >= 1) {
-          // TODO: return errors better than this
-          return FlagParseError(std::get<1>(parse_result));
-        }
-        // T is always slot 0 of the parse result
-        member_ref.field_ref = std::get<0>(parse_result);
-        // If we succeeded, move past the things we consumed.
-        begin = local_begin;
-      } else if (argstr.starts_with(search_name + "=")) {
-        // TODO: Handle the = case
-        assert(false);
-      }
-      // If this arg does not match our flag, we are "satisfied" because there
-      // was no error.
-      return Satisfied{};
+      field_ref = std::get<0>(std::move(parse_result));
     }
+    // If we succeeded, move past the things we consumed.
+    begin = local_begin;
+    return Satisfied{};
   }
 }
 
-} // namespace detail
+// The member at index I of inst was just parsed from every arg in [begin, end),
+// the rest of a window of a stream. Would it have taken more args if the window
+// had gone on? We parse the args again with an empty arg after them, and see
+// if the parse takes it (or fails without something valid there, ex: a
+// std::pmr::vector<int>). Members parsed with ParseInto have already handed
+// their values on, so they can never be parsed again, and are never said to.
+template <class T, size_t I>
+bool parse_wants_more(T &inst, const char **begin, const char **end) {
+  auto &field_ref = std::get<I>(tie_leaves(inst));
+  using field_type = std::remove_reference_t<decltype(field_ref)>;
+  if constexpr (std::is_convertible_v<field_type &, Options> ||
+                has_parse_into<field_type>) {
+    return false;
+  } else {
+    std::array<const char *, ArgStream::max_window_args + 1> args;
+    auto *const args_end = std::copy(begin, end, args.data());
+    *args_end = "";
+    auto *local_begin = args.data();
+    auto const parse_result =
+        ArgParse<field_type>::Parse(local_begin, args_end + 1);
+    return parse_result.index() != 0 || local_begin == args_end + 1;
+  }
+}
 
-template <class T, class... TArgs>
-detail::parse_args_return_type<T> ParseArgs(int argc, const char **argv,
-                                            TArgs &&...args) {
-  using meta_type = MetaInfo<T>;
-  detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
-                                        std::forward<TArgs>(args)...);
-  using pack_type = std::remove_reference_t<std::remove_const_t<
-      decltype(detail::do_on_bindings(std::get<0>(val), [](auto) {}))>>;
-  using unpackable_error_type = detail::UnpackableWrapperError<
-      T, detail::is_unpackable<pack_type, T, decltype([](auto) {})>,
-      pack_type::size>;
-  static_assert(unpackable_error_type::value,
-                "Must have fewer members to be unpackable!");
-  // Only start looking for arguments/options after the program name
-  auto begin = argv + 1;
-  auto const end = argv + argc;
+template <class T, class It>
+using member_parser_type = parse_member_ref_return_type (*)(T &, It &, It);
+
+// One parse function per member, so that a flag (or positional) index from the
+// schema dispatches straight to the one member it belongs to
+template <class T, class It>
+constexpr auto member_parsers = []<size_t... Is>(std::index_sequence<Is...>) {
+  return std::array<member_parser_type<T, It>, sizeof...(Is)>{
+      &try_parse_member_ref<T, Is, It>...};
+}(std::make_index_sequence<Schema<T>::size>{});
+
+template <class T>
+using member_probe_type = bool (*)(T &, const char **, const char **);
+
+// One parse_wants_more per member, indexed like member_parsers
+template <class T>
+constexpr auto member_probes = []<size_t... Is>(std::index_sequence<Is...>) {
+  return std::array<member_probe_type<T>, sizeof...(Is)>{
+      &parse_wants_more<T, Is>...};
+}(std::make_index_sequence<Schema<T>::size>{});
+
+// What an arg is, worked out once before we match it against any member
+enum class TokenKind {
+  // A flag we know of, whose value (if any) is in the args after it
+  Flag,
+  // A flag we know of with its value attached, ex: --name=value
+  FlagWithValue,
+  // "--", after which every arg is taken as a positional
+  EndOfOptions,
+  // Anything else: a positional, a response file or an unknown arg
+  Other,
+};
+
+struct Token {
+  TokenKind kind;
+  // The member (or help_index) a flag belongs to
+  size_t index;
+  // For FlagWithValue, the value after the =. This is a suffix of the arg, so
+  // it is already null terminated.
+  const char *value;
+};
+
+// Classify arg in a single pass: one length scan, at most two flag table
+// lookups, and no copies.
+template <class T>
+constexpr Token classify_token(Schema<T> const &schema, const char *arg) {
+  std::string_view const str(arg);
+  if (str == "--") {
+    return {TokenKind::EndOfOptions, schema.npos, nullptr};
+  }
+  // Only something that looks like an option can have an inline value, so
+  // that positionals with an = in them are left alone. Flag spellings never
+  // have an = in them, so we look up the part before it first.
+  if (str.starts_with('-')) {
+    if (auto const eq = str.find('='); eq != std::string_view::npos) {
+      auto const index = schema.find_flag(str.substr(0, eq));
+      // Help never takes a value
+      if (index != schema.npos && index != schema.help_index) {
+        return {TokenKind::FlagWithValue, index, arg + eq + 1};
+      }
+    }
+  }
+  auto const index = schema.find_flag(str);
+  if (index != schema.npos) {
+    return {TokenKind::Flag, index, nullptr};
+  }
+  return {TokenKind::Other, schema.npos, nullptr};
+}
 
+// Everything about a parse in progress that has to carry over between the
+// ranges of args we parse (ex: from argv into a response file it refers to)
+template <class T> struct ParseState {
+  const char *program_name;
+  // Where to keep the files we read mapped, or null to keep them forever
+  MappedFiles *mapped_files;
+  // The argv we are parsing, to report where errors are in it
+  const char **argv = nullptr;
+  // For a subcommand, the name of the program it is a command of, which help
+  // prints before program_name (the command name), otherwise null
+  const char *parent_program = nullptr;
+  // The index of argv[0] among all of the args, when they are streamed in to
+  // us a window at a time
+  int argv_offset = 0;
   int positionals_decoded = 0;
+  int response_file_depth = 0;
+  // The index in argv of the @path of the response file we are in
+  int response_file_arg = -1;
+  // Set once we have seen "--"
+  bool options_ended = false;
+  // Set while the args we parse are a window of a stream with more args after
+  // it, which the last flag in the window may take values from
+  bool window_open = false;
+  // Where the parse of an open window stopped, at a flag whose values ran up
+  // to the end of the window, left to be parsed with the next window
+  const char **held = nullptr;
+  // The members that were given as flags
+  MemberSet<Schema<T>::size> flags_given{};
+  // The members that were given at all (as flags or positionals, or from a
+  // config file or the environment)
+  MemberSet<Schema<T>::size> members_given{};
+  // Only takes up space when T is instrumented
+  [[no_unique_address]] std::conditional_t<instrumented<T>, ParseStats,
+                                           std::monostate> stats{};
+};
 
-  // Get our options map: member name --> Option if it exists
-  std::unordered_map<std::string_view, Options> options_map;
-  detail::do_on_bindings(std::get<T>(val), [&options_map](auto &&members) {
-    options_map = detail::get_arg_options<T>(members);
-  });
-  int positionals_count = 0;
-  for (auto const &[name, option] : options_map) {
-    if (option.positional) {
-      positionals_count++;
+// The index in argv of the arg at pos, or of the @path of the response file it
+// is in (see ErrorInfo::arg_index)
+template <class T, class It>
+constexpr int arg_index(ParseState<T> const &state, It pos) {
+  if constexpr (std::is_same_v<It, const char **>) {
+    if (state.response_file_depth == 0 && state.argv != nullptr) {
+      return state.argv_offset + static_cast<int>(pos - state.argv);
     }
   }
+  return state.response_file_arg;
+}
+
+// Replace whatever val (a parse_args_return_type) holds with an error of type
+// E, described by info. Always returns false, so that a parse can return
+// fail<E>(...).
+template <class E, class Val>
+constexpr bool fail(Val &val, ErrorInfo const &info) {
+  val.template emplace<E>(E{info});
+  return false;
+}
+
+// Report err, returned by the ArgParse of a member, as happening at info. If
+// the ArgParse gave a code of its own, it is kept over info's.
+template <class Val>
+constexpr bool fail_parse(Val &val, ParseError const &err, ErrorInfo info) {
+  if (err.code != ErrorCode::Unknown) {
+    info.code = err.code;
+  }
+  return fail<ParseError>(val, info);
+}
+
+// Report event to T's instrumentation, if it wants events
+template <class T> void trace(TraceEvent const &event) {
+  if constexpr (requires { instrumentation_type<T>::on_event(event); }) {
+    instrumentation_type<T>::on_event(event);
+  }
+}
+
+// Run the ArgParse for the member at index (parse, which starts at arg), and
+// mark the member as given if it succeeds. Timed and traced if T is
+// instrumented (and we are not parsing at compile time, where there is no
+// clock to read).
+template <class T, class F>
+constexpr parse_member_ref_return_type
+run_member_parse(Schema<T> const &schema, ParseState<T> &state, size_t index,
+                 const char *arg, F &&parse) {
+  auto const timed_parse = [&] {
+    if constexpr (instrumented<T>) {
+      if (!std::is_constant_evaluated()) {
+        auto const start = std::chrono::steady_clock::now();
+        auto result = parse();
+        std::chrono::nanoseconds const elapsed =
+            std::chrono::steady_clock::now() - start;
+        state.stats.member_parses++;
+        state.stats.parse_time += elapsed;
+        trace<T>({TraceEvent::Kind::MemberParse, arg, schema.names[index],
+                  elapsed, !std::holds_alternative<ParseError>(result)});
+        return result;
+      }
+    }
+    return parse();
+  };
+  auto result = timed_parse();
+  if (std::holds_alternative<Satisfied>(result)) {
+    state.members_given.set(index);
+  }
+  return result;
+}
+
+// Parse the member at index from exactly the one arg value (ex: the value of a
+// --flag=value, or an environment variable). Returns false if we hit an error,
+// in which case val holds the error instead, reported at where (which says
+// which arg or config line the value came from).
+template <class T>
+constexpr bool parse_single_value(parse_args_return_type<T> &val,
+                                  Schema<T> const &schema, ParseState<T> &state,
+                                  size_t index, const char *value,
+                                  ErrorInfo where) {
+  const char *values[] = {value};
+  const char **begin = values;
+  auto result = run_member_parse(schema, state, index, value, [&] {
+    return member_parsers<T, const char **>[index](std::get<T>(val), begin,
+                                                   std::end(values));
+  });
+  where.code = ErrorCode::InvalidValue;
+  where.member = static_cast<int>(index);
+  where.value = value;
+  if (auto const *err = std::get_if<ParseError>(&result)) {
+    return fail_parse(val, *err, where);
+  }
+  // The whole value has to be consumed
+  if (begin != std::end(values)) {
+    return fail<ParseError>(val, where);
+  }
+  return true;
+}
+
+template <class T, class It>
+constexpr bool parse_range(parse_args_return_type<T> &val,
+                           Schema<T> const &schema, ParseState<T> &state,
+                           It begin, It const end);
+
+// Keep file mapped for as long as state asks us to. Without a MappedFiles we
+// cannot know when the members (and errors) that point into it are done with,
+// so the mapping is leaked on purpose and lasts for the life of the process.
+template <class T> void keep_mapped(ParseState<T> &state, MappedFile &file) {
+  if (state.mapped_files != nullptr) {
+    state.mapped_files->files.push_back(std::move(file));
+  } else {
+    file.release();
+  }
+}
+
+// The longest config key (including its section) we will look up
+constexpr size_t max_config_key_size = 256;
+
+// Find the member a config key belongs to. A key is the name of a flag without
+// its leading "--" (ex: port for --port), or for renamed flags their full
+// spelling (ex: -p). Keys in a [section] are looked up as section.key.
+template <class T>
+size_t find_config_key(Schema<T> const &schema, ConfigEntry const &entry) {
+  std::array<char, max_config_key_size> buf;
+  auto const size = 2 + (entry.section.empty() ? 0 : entry.section.size() + 1) +
+                    entry.key.size();
+  if (size > buf.size()) {
+    return schema.npos;
+  }
+  auto *out = buf.data();
+  *out++ = '-';
+  *out++ = '-';
+  if (!entry.section.empty()) {
+    out = std::copy(entry.section.begin(), entry.section.end(), out);
+    *out++ = '.';
+  }
+  std::copy(entry.key.begin(), entry.key.end(), out);
+  std::string_view const flag(buf.data(), size);
+  auto index = schema.find_flag(flag);
+  if (index == schema.npos) {
+    index = schema.find_flag(flag.substr(2));
+  }
+  // Help is not something a config file can ask for
+  return index == schema.help_index ? schema.npos : index;
+}
+
+// Map the config file at path and parse each of its values into the member
+// its key belongs to. Returns false if we hit an error, in which case val
+// holds the error instead.
+template <class T>
+bool parse_config(parse_args_return_type<T> &val, Schema<T> const &schema,
+                  ParseState<T> &state, const char *path) {
+  auto file = MappedFile::open(path);
+  if (!file) {
+    return fail<ParseError>(val, {.code = ErrorCode::UnreadableFile,
+                                  .value = path});
+  }
+  ConfigReader reader(file->data(), file->size());
+  keep_mapped(state, *file);
+  ConfigEntry entry;
+  while (true) {
+    auto const status = reader.next(entry);
+    auto const line = static_cast<unsigned>(reader.line());
+    switch (status) {
+    case ConfigReader::Status::End:
+      return true;
+    case ConfigReader::Status::Error:
+      return fail<ParseError>(
+          val, {.code = ErrorCode::BadConfigLine, .line = line, .value = path});
+    case ConfigReader::Status::Entry:
+      break;
+    }
+    auto const index = find_config_key(schema, entry);
+    if (index == schema.npos) {
+      if constexpr (!MetaInfo<T>::extra_args_ok) {
+        return fail<UnknownArgError>(
+            val, {.code = ErrorCode::UnknownArg, .line = line, .value = path});
+      } else {
+        continue;
+      }
+    }
+    if (!parse_single_value(val, schema, state, index, entry.value,
+                            {.line = line})) {
+      return false;
+    }
+  }
+}
+
+// Map the response file at path, tokenize it in place, and parse its tokens
+// as if they had been in argv where the @path was
+template <class T>
+bool parse_response_file(parse_args_return_type<T> &val,
+                         Schema<T> const &schema, ParseState<T> &state,
+                         const char *path) {
+  if (state.response_file_depth >= max_response_file_depth) {
+    return fail<ParseError>(val, {.code = ErrorCode::ResponseFileDepth,
+                                  .arg_index = state.response_file_arg,
+                                  .value = path});
+  }
+  auto file = MappedFile::open(path);
+  if (!file) {
+    return fail<ParseError>(val, {.code = ErrorCode::UnreadableFile,
+                                  .arg_index = state.response_file_arg,
+                                  .value = path});
+  }
+  auto const tokens_end = tokenize_in_place(file->data(), file->size());
+  NulTokenIterator const begin(file->data());
+  NulTokenIterator const end(tokens_end);
+  keep_mapped(state, *file);
+  state.response_file_depth++;
+  bool const ok = parse_range(val, schema, state, begin, end);
+  state.response_file_depth--;
+  return ok;
+}
+
+// Parse the args in [begin, end) into the T held by val. Returns false if we
+// hit an error, in which case val holds the error instead.
+template <class T, class It>
+constexpr bool parse_range(parse_args_return_type<T> &val,
+                           Schema<T> const &schema, ParseState<T> &state,
+                           It begin, It const end) {
+  using meta_type = MetaInfo<T>;
+  auto &inst = std::get<T>(val);
+  auto const &parsers = member_parsers<T, It>;
 
   while (begin != end) {
-    // Check to see if we have help first
-    if (detail::is_help<T>(*begin)) {
-      detail::display_help(std::get<T>(val), argv[0]);
-      return UsageError{};
-    }
-    // Now try to see if we have any members that match, or if we don't,
-    // if we have any positionals we would parse here
-    detail::do_on_bindings(
-        std::get<T>(val),
-        [&val, &begin, end, &options_map = std::as_const(options_map),
-         &positionals_decoded](auto &&members) {
-          // Walk each of the members and attempt to parse the values at begin
-          auto old_begin = begin;
-          int num_positionals = 0;
-          auto results = std::apply(
-              [&begin, end, &options_map, &positionals_decoded,
-               &num_positionals](auto &...member_refs) {
-                // Used for counting the number of positionals we have in our
-                // members to match
-                return std::array{detail::try_parse_member_ref(
-                    member_refs, options_map, positionals_decoded,
-                    num_positionals, begin, end)...};
-              },
-              members);
-          // For our results, if our begin pointer hasn't moved, we ONLY have
-          // failed if:
-          // 1. we DID have a flag/positional there but we couldn't parse it
-          // 2. we encountered something we don't know how to parse and we
-          // have passed all of our positional args
-          if (old_begin == begin) {
-            // Error reporting precedence:
-            // 1. UsageError
-            // 2. FlagParseError
-            // 3. PositionalParseError
-            // 4. All satisfied, unknown arg
-            detail::FlagParseError const *flag_error{};
-            detail::PositionalParseError const *pos_error{};
-            for (auto const &res : results) {
-              if (auto const *usage = std::get_if<UsageError>(&res)) {
-                // If we ever see a UsageError, exit immediately
-                val.template emplace<UsageError>(*usage);
-                return;
-              } else if (auto const *fl =
-                             std::get_if<detail::FlagParseError>(&res)) {
-                // assert that we don't have a flag error. We should never
-                // have two flags fail
-                assert(flag_error == nullptr);
-                flag_error = fl;
-              } else if (auto const *p =
-                             std::get_if<detail::PositionalParseError>(&res)) {
-                // assert that we don't have a positional error. We should
-                // never have two pos flags fail
-                assert(pos_error == nullptr);
-                pos_error = p;
-              }
-            }
-            if (flag_error) {
-              val.template emplace<ParseError>(*flag_error);
-              return;
-            }
-            if (pos_error) {
-              val.template emplace<ParseError>(*pos_error);
-              return;
-            }
-            // Finally, if we disallow unknown args, handle that here
-            if constexpr (!meta_type::extra_args_ok) {
-              // TODO: Fill this out
-              val.template emplace<UnknownArgError>();
-              return;
-            } else {
-              // If we support extra args that we don't know about, skip this
-              // by moving begin
-              begin++;
-            }
+    auto const token = state.options_ended
+                           ? Token{TokenKind::Other, schema.npos, nullptr}
+                           : classify_token(schema, *begin);
+    if constexpr (instrumented<T>) {
+      bool const is_flag = token.index < schema.size;
+      state.stats.tokens++;
+      state.stats.flag_hits += is_flag ? 1 : 0;
+      if (!std::is_constant_evaluated()) {
+        trace<T>({TraceEvent::Kind::Token, *begin,
+                  is_flag ? schema.names[token.index] : std::string_view()});
+      }
+    }
+    // Flags with disallow_multiflag may only be given once
+    if (token.index < schema.size && state.flags_given.test(token.index) &&
+        schema.single.test(token.index)) {
+      return fail<UsageError>(val, {.code = ErrorCode::DuplicateFlag,
+                                    .arg_index = arg_index(state, begin),
+                                    .member = static_cast<int>(token.index),
+                                    .value = *begin});
+    }
+    switch (token.kind) {
+    case TokenKind::Flag: {
+      // Check to see if we have help first
+      if (token.index == schema.help_index) {
+        if (!std::is_constant_evaluated()) {
+          display_help(schema, inst, state.program_name,
+                       state.parent_program);
+        }
+        return fail<UsageError>(val, {.code = ErrorCode::Help,
+                                      .arg_index = arg_index(state, begin)});
+      }
+      // The flag we are looking for matches! Lets try to parse its value from
+      // the args after it, and assign it to the member
+      auto const value_begin = std::next(begin);
+      // A window of a stream can end part way through the values of a flag
+      // (see ParseState::held), so a flag at the end of one waits for the next
+      if constexpr (std::is_same_v<It, const char **>) {
+        if (state.window_open && value_begin == end) {
+          state.held = begin;
+          return true;
+        }
+      }
+      auto local_begin = value_begin;
+      bool const has_value = value_begin != end;
+      auto result = run_member_parse(
+          schema, state, token.index, has_value ? *value_begin : nullptr,
+          [&] { return parsers[token.index](inst, local_begin, end); });
+      if (auto const *err = std::get_if<ParseError>(&result)) {
+        // Point at the value we could not parse, or at the flag if it has none
+        return fail_parse(
+            val, *err,
+            {.code = has_value ? ErrorCode::InvalidValue
+                               : ErrorCode::MissingValue,
+             .arg_index = arg_index(state, has_value ? value_begin : begin),
+             .member = static_cast<int>(token.index),
+             .value = has_value ? *value_begin : nullptr});
+      }
+      // A flag that took every arg up to the end of the window, and would
+      // have taken more, may have more values in the next one. It is parsed
+      // again from there with all of them, replacing what we just parsed.
+      if constexpr (std::is_same_v<It, const char **>) {
+        if (state.window_open && local_begin == end &&
+            member_probes<T>[token.index](inst, value_begin, end)) {
+          state.held = begin;
+          return true;
+        }
+      }
+      state.flags_given.set(token.index);
+      begin = local_begin;
+      continue;
+    }
+    case TokenKind::FlagWithValue:
+      if (!parse_single_value(val, schema, state, token.index, token.value,
+                              {.arg_index = arg_index(state, begin)})) {
+        return false;
+      }
+      state.flags_given.set(token.index);
+      ++begin;
+      continue;
+    case TokenKind::EndOfOptions:
+      state.options_ended = true;
+      ++begin;
+      continue;
+    case TokenKind::Other:
+      break;
+    }
+    if constexpr (response_files_enabled<T>) {
+      const char *arg = *begin;
+      if (arg[0] == '@' && !state.options_ended) {
+        if (state.response_file_depth == 0) {
+          state.response_file_arg = arg_index(state, begin);
+        }
+        if (std::is_constant_evaluated()) {
+          // Files cannot be read at compile time
+          return fail<ParseError>(val, {.code = ErrorCode::UnreadableFile,
+                                        .arg_index = state.response_file_arg,
+                                        .value = arg + 1});
+        }
+        if (!parse_response_file(val, schema, state, arg + 1)) {
+          return false;
+        }
+        ++begin;
+        continue;
+      }
+    }
+    // If we have any positionals left to decode, this arg is the next one.
+    // After them, every positional goes to our variadic positional.
+    auto const index = state.positionals_decoded < schema.positionals_count
+                           ? schema.positionals[state.positionals_decoded]
+                           : schema.variadic_positional;
+    if (index != schema.npos) {
+      auto local_begin = begin;
+      auto result = run_member_parse(schema, state, index, *begin, [&] {
+        return parsers[index](inst, local_begin, end);
+      });
+      if (auto const *err = std::get_if<ParseError>(&result)) {
+        return fail_parse(val, *err,
+                          {.code = ErrorCode::InvalidPositional,
+                           .arg_index = arg_index(state, begin),
+                           .member = static_cast<int>(index),
+                           .value = *begin});
+      }
+      if (local_begin != begin) {
+        // Then move past what we consumed and increment our number of decoded
+        // positionals
+        begin = local_begin;
+        if (index != schema.variadic_positional) {
+          state.positionals_decoded++;
+        }
+        continue;
+      }
+    }
+    // Finally, if we disallow unknown args, handle that here
+    if constexpr (!meta_type::extra_args_ok) {
+      return fail<UnknownArgError>(val, {.code = ErrorCode::UnknownArg,
+                                         .arg_index = arg_index(state, begin),
+                                         .value = *begin});
+    } else {
+      // If we support extra args that we don't know about, skip this
+      // by moving begin
+      ++begin;
+    }
+  }
+  return true;
+}
+
+// Fill in the flags that were not given from their environment variables (if
+// they have one and it is set). envp is scanned once, looking each variable up
+// in the schema, rather than looking up each member's variable separately.
+// Returns false if we hit an error, in which case val holds the error instead.
+template <class T>
+bool parse_env(parse_args_return_type<T> &val, Schema<T> const &schema,
+               ParseState<T> &state, char const *const *envp) {
+  if (schema.envs_count == 0 || envp == nullptr) {
+    return true;
+  }
+  std::array<const char *, Schema<T>::size> values{};
+  for (; *envp != nullptr; envp++) {
+    std::string_view const entry(*envp);
+    auto const eq = entry.find('=');
+    if (eq == std::string_view::npos) {
+      continue;
+    }
+    auto const index = schema.find_env(entry.substr(0, eq));
+    if (index != schema.npos && !state.flags_given.test(index)) {
+      values[index] = *envp + eq + 1;
+    }
+  }
+  for (size_t i = 0; i < values.size(); i++) {
+    if (values[i] != nullptr &&
+        !parse_single_value(val, schema, state, i, values[i], {})) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ArgParse<T>::Complete is an optional way to offer shell completions for a
+// value of T. It is called with the (partial) word being completed, and calls
+// add with each candidate (a std::string_view). Candidates that do not start
+// with the word are dropped for it, so it is fine to add every value there is.
+template <class T>
+concept has_complete =
+    requires(std::string_view word, void (*add)(std::string_view)) {
+      ArgParse<T>::Complete(word, add);
+    };
+
+// Write the candidates for a value of the member at index I that start with
+// word, each prefixed with lead (ex: "--flag=")
+template <class T, size_t I>
+void complete_member(std::string_view word, std::string_view lead,
+                     OutputBuffer &out) {
+  using refs_type = typename Schema<T>::refs_type;
+  using field_type =
+      std::remove_reference_t<std::tuple_element_t<I, refs_type>>;
+  if constexpr (!std::is_convertible_v<field_type &, Options> &&
+                has_complete<field_type>) {
+    ArgParse<field_type>::Complete(word, [&](std::string_view candidate) {
+      if (candidate.starts_with(word)) {
+        out.append(lead);
+        out.append(candidate);
+        out.newline();
+      }
+    });
+  }
+}
+
+using member_completer_type = void (*)(std::string_view, std::string_view,
+                                       OutputBuffer &);
+
+template <class T>
+constexpr auto member_completers =
+    []<size_t... Is>(std::index_sequence<Is...>) {
+      return std::array<member_completer_type, sizeof...(Is)>{
+          &complete_member<T, Is>...};
+    }(std::make_index_sequence<Schema<T>::size>{});
+
+// Answer a shell completion request: words are the words on the command line
+// after the program name, the last of which is the (partial) word to complete.
+// Every candidate is written on its own line. Flags come straight out of the
+// sorted flag table (a binary search, then a scan of the flags that share the
+// prefix), and values come from ArgParse<T>::Complete.
+template <class T>
+void complete(Schema<T> const &schema, const char *const *words,
+              size_t count) {
+  OutputBuffer out;
+  std::string_view const word = count > 0 ? words[count - 1] : "";
+  // Walk the words before it, to work out what the word is for
+  int positionals = 0;
+  bool options_ended = false;
+  size_t value_for = schema.npos;
+  for (size_t w = 0; w + 1 < count; w++) {
+    if (value_for != schema.npos) {
+      value_for = schema.npos;
+      continue;
+    }
+    if (options_ended) {
+      positionals++;
+      continue;
+    }
+    auto const token = classify_token(schema, words[w]);
+    switch (token.kind) {
+    case TokenKind::Flag:
+      if (token.index != schema.help_index) {
+        value_for = token.index;
+      }
+      break;
+    case TokenKind::FlagWithValue:
+      break;
+    case TokenKind::EndOfOptions:
+      options_ended = true;
+      break;
+    case TokenKind::Other:
+      positionals++;
+      break;
+    }
+  }
+  if (value_for != schema.npos) {
+    member_completers<T>[value_for](word, "", out);
+    return;
+  }
+  auto const next_positional = positionals < schema.positionals_count
+                                   ? schema.positionals[positionals]
+                                   : schema.variadic_positional;
+  bool const positional_next = next_positional != schema.npos;
+  if (!options_ended &&
+      (word.starts_with('-') || (word.empty() && !positional_next))) {
+    if (auto const eq = word.find('='); eq != std::string_view::npos) {
+      auto const index = schema.find_flag(word.substr(0, eq));
+      if (index != schema.npos && index != schema.help_index) {
+        member_completers<T>[index](word.substr(eq + 1), word.substr(0, eq + 1),
+                                    out);
+      }
+      return;
+    }
+    auto const flags_end = schema.flags.begin() + schema.flags_count;
+    for (auto itr = schema.find_flag_prefix(word);
+         itr != flags_end && itr->flag.starts_with(word); ++itr) {
+      out.append(itr->flag.prefix);
+      out.append(itr->flag.name);
+      out.newline();
+    }
+    return;
+  }
+  if (positional_next) {
+    member_completers<T>[next_positional](word, "", out);
+  }
+}
+
+// Fail if T itself cannot be parsed into (see ErrorCode::BadSchema), before
+// anything is read
+template <class T>
+constexpr bool check_schema(parse_args_return_type<T> &val,
+                            Schema<T> const &schema) {
+  if (schema.bad_member < 0) {
+    return true;
+  }
+  return fail<UsageError>(
+      val, {.code = ErrorCode::BadSchema, .member = schema.bad_member});
+}
+
+// Fail unless every required member was given (from any source). This is a
+// mask comparison, rather than a walk over the members.
+template <class T>
+constexpr bool check_required(parse_args_return_type<T> &val,
+                              Schema<T> const &schema,
+                              ParseState<T> const &state) {
+  auto const missing = schema.required.without(state.members_given);
+  if (!missing.any()) {
+    return true;
+  }
+  ErrorInfo info{.code = ErrorCode::MissingRequired,
+                 .member = static_cast<int>(missing.first()),
+                 .missing_count = static_cast<unsigned>(missing.count())};
+  std::copy_n(missing.words.begin(),
+              std::min(missing.words.size(), info.missing.words.size()),
+              info.missing.words.begin());
+  return fail<UsageError>(val, info);
+}
+
+// Read the environment, and then check that everything that had to be given
+// was. Done once all of the args are parsed, since flags win over the
+// environment.
+template <class T>
+constexpr void finish_parse(parse_args_return_type<T> &val,
+                            Schema<T> const &schema, ParseState<T> &state) {
+  // There is no environment to read at compile time
+  if (!std::is_constant_evaluated() &&
+      !parse_env(val, schema, state, environ)) {
+    return;
+  }
+  // If we reached the end of our args, AND we didn't decode our positionals
+  // we error out here
+  if (state.positionals_decoded < schema.positionals_count) {
+    auto const missing = schema.positionals[state.positionals_decoded];
+    fail<UsageError>(val, {.code = ErrorCode::MissingPositional,
+                           .member = static_cast<int>(missing)});
+    return;
+  }
+  check_required(val, schema, state);
+}
+
+// Parse every source (config_path, then argc/argv, then the environment) into
+// the T held by val. On any error, val holds the error instead.
+template <class T>
+constexpr void parse_sources(parse_args_return_type<T> &val,
+                             Schema<T> const &schema, ParseState<T> &state,
+                             int argc, const char **argv,
+                             const char *config_path) {
+  if (config_path != nullptr &&
+      !parse_config(val, schema, state, config_path)) {
+    return;
+  }
+  // Only start looking for arguments/options after the program name
+  auto const begin = argc > 0 ? argv + 1 : argv;
+  if (!parse_range(val, schema, state, begin, argv + std::max(argc, 0))) {
+    return;
+  }
+  finish_parse(val, schema, state);
+}
+
+// Run parse (with state), and report its stats if T is instrumented (and we
+// are not parsing at compile time)
+template <class T, class F>
+constexpr void instrument_parse(ParseState<T> &state, F &&parse) {
+  if constexpr (!instrumented<T>) {
+    parse();
+  } else {
+    if (std::is_constant_evaluated()) {
+      parse();
+      return;
+    }
+    using instrumentation = instrumentation_type<T>;
+    size_t allocations = 0;
+    if constexpr (requires { instrumentation::allocations(); }) {
+      allocations = instrumentation::allocations();
+    }
+    auto const start = std::chrono::steady_clock::now();
+    parse();
+    state.stats.total_time = std::chrono::steady_clock::now() - start;
+    if constexpr (requires { instrumentation::allocations(); }) {
+      state.stats.allocations = instrumentation::allocations() - allocations;
+    }
+    if constexpr (requires { instrumentation::on_stats(state.stats); }) {
+      instrumentation::on_stats(state.stats);
+    }
+  }
+}
+
+// Parse argc/argv into the T held by val, using a schema that was already
+// resolved for T. If config_path is given, the config file there is parsed
+// first, so that argv (and then the environment) override it. For a
+// subcommand, argv starts at the command name and parent_program is the name
+// of the program. On any error, val holds the error instead.
+template <class T>
+constexpr void parse_args(parse_args_return_type<T> &val,
+                          Schema<T> const &schema, int argc, const char **argv,
+                          MappedFiles *mapped_files = nullptr,
+                          const char *config_path = nullptr,
+                          const char *parent_program = nullptr) {
+  if (!check_schema(val, schema)) {
+    return;
+  }
+  if constexpr (!complete_arg<T>.empty()) {
+    // Completion has to print, so it is only answered at run time
+    if (!std::is_constant_evaluated() && argc > 1 &&
+        complete_arg<T> == argv[1]) {
+      complete(schema, argv + 2, static_cast<size_t>(argc - 2));
+      fail<UsageError>(val, {.code = ErrorCode::Completion, .arg_index = 1});
+      return;
+    }
+  }
+  ParseState<T> state{argc > 0 ? argv[0] : "", mapped_files, argv,
+                      parent_program};
+  instrument_parse(state, [&] {
+    parse_sources(val, schema, state, argc, argv, config_path);
+  });
+}
+
+// Parse only the config file at path (and the environment) into the T held by
+// val. Positionals are left as they are, since a config file cannot give them,
+// but required flags still have to be given.
+template <class T>
+void parse_config_only(parse_args_return_type<T> &val, Schema<T> const &schema,
+                       const char *path, MappedFiles *mapped_files = nullptr) {
+  if (!check_schema(val, schema)) {
+    return;
+  }
+  ParseState<T> state{"", mapped_files};
+  instrument_parse(state, [&] {
+    if (parse_config(val, schema, state, path) &&
+        parse_env(val, schema, state, environ)) {
+      check_required(val, schema, state);
+    }
+  });
+}
+
+// Parse the args read from stream, a window at a time, and then the
+// environment into the T held by val
+template <class T>
+void parse_stream(parse_args_return_type<T> &val, Schema<T> const &schema,
+                  ArgStream &stream) {
+  if (!check_schema(val, schema)) {
+    return;
+  }
+  ParseState<T> state{"", nullptr};
+  instrument_parse(state, [&] {
+    size_t keep = 0;
+    while (true) {
+      auto const status = stream.next(keep);
+      if (status == ArgStream::Status::ReadError) {
+        fail<ParseError>(val, {.code = ErrorCode::UnreadableFile,
+                               .arg_index = state.argv_offset});
+        return;
+      }
+      auto args = stream.args();
+      if (status == ArgStream::Status::TooLong) {
+        fail<ParseError>(val, {.code = ErrorCode::ArgTooLong,
+                               .arg_index = state.argv_offset +
+                                            static_cast<int>(args.size())});
+        return;
+      }
+      bool const last = status == ArgStream::Status::Last;
+      auto const window_end = args.data() + args.size();
+      // parse_range stops early (at state.held) at a flag that may take
+      // values from the next window, and everything from it on is kept to be
+      // parsed again with the next window
+      state.window_open = !last;
+      state.held = nullptr;
+      state.argv = args.data();
+      if (!parse_range(val, schema, state, args.data(), window_end)) {
+        return;
+      }
+      if (last) {
+        break;
+      }
+      keep = state.held != nullptr
+                 ? static_cast<size_t>(window_end - state.held)
+                 : 0;
+      state.argv_offset += static_cast<int>(args.size() - keep);
+    }
+    finish_parse(val, schema, state);
+  });
+}
+
+template <class T> struct is_variant : std::false_type {};
+template <class... Ts>
+struct is_variant<std::variant<Ts...>> : std::true_type {};
+
+// Maps a command name to the index of the command in a variant
+struct CommandEntry {
+  std::string_view name;
+  size_t index;
+};
+
+// Parses a command line of the form "program <command> <args>...", where the
+// command picks which of Cmds to parse the rest of the args into.
+template <class T> struct Subcommands;
+template <class... Cmds> struct Subcommands<std::variant<Cmds...>> {
+  using variant_type = std::variant<Cmds...>;
+  // Any command may be strict about its args, so we can return all errors
+  using return_type =
+      std::variant<variant_type, UsageError, ParseError, UnknownArgError>;
+
+  // The name of each of Cmds, sorted so that the command can be binary
+  // searched
+  constexpr static auto commands = [] {
+    std::array<CommandEntry, sizeof...(Cmds)> table{};
+    size_t i = 0;
+    ((table[i] = {command_name<Cmds>, i}, i++), ...);
+    std::sort(table.begin(), table.end(),
+              [](CommandEntry const &lhs, CommandEntry const &rhs) {
+                return lhs.name < rhs.name;
+              });
+    return table;
+  }();
+  static_assert(std::adjacent_find(commands.begin(), commands.end(),
+                                   [](CommandEntry const &lhs,
+                                      CommandEntry const &rhs) {
+                                     return lhs.name == rhs.name;
+                                   }) == commands.end(),
+                "Every subcommand must have a different command_name!");
+
+  // Parse args into the command at index I. Only the command that is picked
+  // is ever reflected, so the cost of a parse does not grow with the number
+  // of commands.
+  template <size_t I>
+  static void parse_command(return_type &val, int argc, const char **argv,
+                            const char *program_name) {
+    using command_type = std::variant_alternative_t<I, variant_type>;
+    parse_args_return_type<command_type> result(
+        std::in_place_type_t<command_type>{});
+    auto const &schema = get_schema(std::get<command_type>(result));
+    parse_args(result, schema, argc, argv, nullptr, nullptr, program_name);
+    std::visit(
+        [&val](auto &&r) {
+          using result_type = std::remove_cvref_t<decltype(r)>;
+          if constexpr (std::is_same_v<result_type, command_type>) {
+            val.template emplace<variant_type>(std::in_place_index<I>,
+                                               std::move(r));
           } else {
-            // If begin moved at all, we had to have at least some case of no
-            // error
-            // TODO: Debug log
+            // The command's args start after its name, so their indices in
+            // the whole argv are one more than they were for the command
+            if (r.arg_index >= 0) {
+              r.arg_index++;
+            }
+            val.template emplace<result_type>(std::move(r));
           }
+        },
+        std::move(result));
+  }
+
+  constexpr static auto parsers = []<size_t... Is>(std::index_sequence<Is...>) {
+    return std::array{&parse_command<Is>...};
+  }(std::index_sequence_for<Cmds...>{});
+
+  // Complete words for the command at index I (words start after its name)
+  template <size_t I>
+  static void complete_command(const char *const *words, size_t count) {
+    using command_type = std::variant_alternative_t<I, variant_type>;
+    command_type inst{};
+    detail::complete(get_schema(inst), words, count);
+  }
+
+  constexpr static auto completers =
+      []<size_t... Is>(std::index_sequence<Is...>) {
+        return std::array{&complete_command<Is>...};
+      }(std::index_sequence_for<Cmds...>{});
+
+  // Complete the command name, or hand the rest of the words to the command
+  static void complete(const char *const *words, size_t count) {
+    if (count > 1) {
+      std::string_view const name(words[0]);
+      auto itr = std::lower_bound(
+          commands.begin(), commands.end(), name,
+          [](CommandEntry const &entry, std::string_view n) {
+            return entry.name < n;
+          });
+      if (itr != commands.end() && itr->name == name) {
+        completers[itr->index](words + 1, count - 1);
+      }
+      return;
+    }
+    std::string_view const word = count > 0 ? words[0] : "";
+    OutputBuffer out;
+    for (auto itr = std::lower_bound(
+             commands.begin(), commands.end(), word,
+             [](CommandEntry const &entry, std::string_view w) {
+               return entry.name < w;
+             });
+         itr != commands.end() && itr->name.starts_with(word); ++itr) {
+      out.append(itr->name);
+      out.newline();
+    }
+  }
+
+  static void display_help(const char *program_name) {
+    OutputBuffer out;
+    out.append("Usage: ");
+    out.append(program_name);
+    out.append(" <command>");
+    out.newline();
+    out.append("Commands:");
+    out.newline();
+    for (auto const &command : commands) {
+      out.append("  ");
+      out.append(command.name);
+      out.newline();
+    }
+  }
+
+  static return_type parse(int argc, const char **argv) {
+    return_type val(std::in_place_type_t<UsageError>{});
+    const char *program_name = argc > 0 ? argv[0] : "";
+    if constexpr (!complete_arg<variant_type>.empty()) {
+      if (argc > 1 && complete_arg<variant_type> == argv[1]) {
+        complete(argv + 2, static_cast<size_t>(argc - 2));
+        val.template emplace<UsageError>(
+            UsageError{{.code = ErrorCode::Completion, .arg_index = 1}});
+        return val;
+      }
+    }
+    if (argc < 2 || is_help<variant_type>(argv[1])) {
+      display_help(program_name);
+      int const help_arg = argc < 2 ? -1 : 1;
+      val.template emplace<UsageError>(
+          UsageError{{.code = ErrorCode::Help, .arg_index = help_arg}});
+      return val;
+    }
+    std::string_view const name(argv[1]);
+    auto itr = std::lower_bound(
+        commands.begin(), commands.end(), name,
+        [](CommandEntry const &entry, std::string_view n) {
+          return entry.name < n;
         });
-    if (val.index() != 0) {
-      // If we have an error to report, lets stop parsing the rest
+    if (itr == commands.end() || itr->name != name) {
+      val.template emplace<UnknownArgError>(
+          UnknownArgError{{.code = ErrorCode::UnknownCommand,
+                           .arg_index = 1,
+                           .value = argv[1]}});
       return val;
     }
+    // The command name takes the place of the program name for its args, and
+    // help names both
+    parsers[itr->index](val, argc - 1, argv + 1, program_name);
+    return val;
   }
-  // If begin == end here, AND we didn't decode our positionals
-  // TODO: or our required flags
-  // we error out here
-  if (positionals_decoded < positionals_count) {
-    val.template emplace<UsageError>();
+};
+
+// What code means, as the start of a message
+constexpr std::string_view describe(ErrorCode code) {
+  switch (code) {
+  case ErrorCode::Unknown:
+    return "could not parse arguments";
+  case ErrorCode::InvalidValue:
+    return "invalid value";
+  case ErrorCode::MissingValue:
+    return "missing value";
+  case ErrorCode::InvalidPositional:
+    return "invalid argument";
+  case ErrorCode::UnknownArg:
+    return "unknown argument";
+  case ErrorCode::UnknownCommand:
+    return "unknown command";
+  case ErrorCode::UnreadableFile:
+    return "could not read file";
+  case ErrorCode::ResponseFileDepth:
+    return "response files nested too deeply";
+  case ErrorCode::ArgTooLong:
+    return "argument too long for the read buffer";
+  case ErrorCode::DuplicateFlag:
+    return "flag given more than once";
+  case ErrorCode::MissingRequired:
+    return "missing required";
+  case ErrorCode::BadConfigLine:
+    return "bad config line";
+  case ErrorCode::Help:
+    return "help requested";
+  case ErrorCode::Completion:
+    return "completion requested";
+  case ErrorCode::MissingPositional:
+    return "missing argument";
+  case ErrorCode::BadSchema:
+    return "bad schema";
+  }
+  return "could not parse arguments";
+}
+
+// Appends to [pos, last) in the style of std::to_chars, remembering if we ran
+// out of room
+struct ErrorWriter {
+  char *pos;
+  char *last;
+  bool overflow = false;
+
+  void append(std::string_view str) {
+    if (overflow || static_cast<size_t>(last - pos) < str.size()) {
+      overflow = true;
+      return;
+    }
+    pos = std::copy(str.begin(), str.end(), pos);
+  }
+  void append_number(size_t n) {
+    auto const [ptr, ec] = std::to_chars(pos, last, n);
+    if (overflow || ec != std::errc{}) {
+      overflow = true;
+      return;
+    }
+    pos = ptr;
   }
+  std::to_chars_result result() const {
+    if (overflow) {
+      return {last, std::errc::value_too_large};
+    }
+    return {pos, std::errc{}};
+  }
+};
+
+} // namespace detail
+
+// Parse argc/argv into a T constructed from args.
+// LIFETIME: response files (see MetaInfo::response_files) stay mapped for the
+// life of the process, since members may point into them. Use
+// Parser<T>::parse with a MappedFiles to unmap them sooner.
+template <class T, class... TArgs>
+  requires(!detail::is_variant<T>::value)
+constexpr detail::parse_args_return_type<T>
+ParseArgs(int argc, const char **argv, TArgs &&...args) {
+  detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                        std::forward<TArgs>(args)...);
+  if (std::is_constant_evaluated()) {
+    // There is no cached schema at compile time, so this parse builds its own
+    detail::Schema<T> const schema(std::get<T>(val));
+    detail::parse_args(val, schema, argc, argv);
+    return val;
+  }
+  // Our member names, Options and flag table are built once per type, not per
+  // parse
+  auto const &schema = detail::get_schema(std::get<T>(val));
+  detail::parse_args(val, schema, argc, argv);
+  return val;
+}
+
+// Parse a fixed command line, such as a profile that is compiled into the
+// program. Unlike argv, this can be done at compile time, where a bad command
+// line is a compile error rather than a startup cost:
+//   constexpr auto fast = ParseArgs<Server>(std::array{"server", "-w", "8"});
+//   static_assert(fast.index() == 0);
+// Only argv is read at compile time. There is no environment there, and no
+// files, so @path response files are a ParseError. Types are parsed with the
+// same ArgParse as at run time, so T's members have to be of types whose
+// ArgParse is constexpr (integers, std::string_view and const char* in
+// clapp/types.hpp).
+template <class T, size_t N, class... TArgs>
+  requires(!detail::is_variant<T>::value)
+constexpr detail::parse_args_return_type<T>
+ParseArgs(std::array<const char *, N> args, TArgs &&...targs) {
+  return ParseArgs<T>(static_cast<int>(N), args.data(),
+                      std::forward<TArgs>(targs)...);
+}
+
+// Parse argc/argv with every allocation the parse makes (ex: for
+// std::pmr::string members, see ParseResource) coming from resource, so that
+// they can all be freed at once (ex: by releasing a
+// std::pmr::monotonic_buffer_resource). Members that allocate have to use a
+// std::pmr allocator to be allocated from resource.
+template <class T, class... TArgs>
+  requires(!detail::is_variant<T>::value)
+detail::parse_args_return_type<T> ParseArgs(std::pmr::memory_resource *resource,
+                                            int argc, const char **argv,
+                                            TArgs &&...args) {
+  detail::ResourceScope const scope(resource);
+  return ParseArgs<T>(argc, argv, std::forward<TArgs>(args)...);
+}
+
+// Parse the null delimited args read from fd (like xargs -0, ex: piped from
+// find -print0) into a T, as if they were argv without the program name. Args
+// are read into buffer and parsed a window at a time, as they arrive, so a
+// stream of any length is parsed in the memory of buffer, which has to be
+// longer than the longest arg (and than any flag and all of its values
+// together, which are always parsed from the same window).
+// Errors give the index of the arg in the stream (from 0).
+// LIFETIME: buffer is reused for each window, so members should own their
+// values (ex: std::string rather than std::string_view). The value of an error
+// points into buffer.
+template <class T, class... TArgs>
+  requires(!detail::is_variant<T>::value)
+detail::parse_args_return_type<T>
+ParseArgStream(int fd, std::span<char> buffer, TArgs &&...args) {
+  detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                        std::forward<TArgs>(args)...);
+  auto const &schema = detail::get_schema(std::get<T>(val));
+  detail::ArgStream stream(fd, buffer);
+  detail::parse_stream(val, schema, stream);
   return val;
-}
\ No newline at end of file
+}
+
+// Subcommands: ParseArgs<std::variant<BuildCmd, RunCmd>> parses a command line
+// of the form "program <command> <args>...". The command is looked up by the
+// MetaInfo<Cmd>::command_name of each of the alternatives, and the rest of the
+// args are parsed into it as if the command name were the program name.
+template <class T>
+  requires detail::is_variant<T>::value
+typename detail::Subcommands<T>::return_type ParseArgs(int argc,
+                                                       const char **argv) {
+  return detail::Subcommands<T>::parse(argc, argv);
+}
+
+// Parse the INI style config file at path into a T (see ConfigReader for the
+// format). Keys are flag names without their leading "--" (ex: port = 80 for
+// --port), and [section] headers prefix the keys after them with section.
+// Values are parsed with the same ArgParse as the flag would be.
+// LIFETIME: the file stays mapped for the life of the process, since members
+// may point into it. Use Parser<T>::parse_config with a MappedFiles to unmap it
+// sooner.
+template <class T, class... TArgs>
+detail::parse_args_return_type<T> ParseConfig(const char *path,
+                                              TArgs &&...args) {
+  detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                        std::forward<TArgs>(args)...);
+  auto const &schema = detail::get_schema(std::get<T>(val));
+  detail::parse_config_only(val, schema, path);
+  return val;
+}
+
+// Parse the config file at config_path (see ParseConfig), then argc/argv on top
+// of it, so that flags override the config file. Like ParseConfig, the files
+// read stay mapped for the life of the process.
+template <class T, class... TArgs>
+detail::parse_args_return_type<T> ParseArgsWithConfig(const char *config_path,
+                                                      int argc,
+                                                      const char **argv,
+                                                      TArgs &&...args) {
+  detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                        std::forward<TArgs>(args)...);
+  auto const &schema = detail::get_schema(std::get<T>(val));
+  detail::parse_args(val, schema, argc, argv, nullptr, config_path);
+  return val;
+}
+
+// A reusable parser for T. Everything ParseArgs would work out about T (the
+// schema: member names, Options, positional ordering and the flag table) is
+// resolved when the Parser is built, so each parse only has to walk the args.
+// parse is const and only reads shared state, so a single Parser can be used
+// from many threads at once.
+template <class T> class Parser {
+public:
+  // Every parse starts from a copy of a T constructed from args
+  template <class... TArgs>
+    requires std::constructible_from<T, TArgs...>
+  explicit Parser(TArgs &&...args)
+      : prototype(std::forward<TArgs>(args)...),
+        schema(detail::get_schema(prototype)) {}
+
+  detail::parse_args_return_type<T> parse(int argc, const char **argv) const {
+    detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                          prototype);
+    detail::parse_args(val, schema, argc, argv);
+    return val;
+  }
+
+  // Parse argc/argv, allocating from resource (see ParseArgs)
+  detail::parse_args_return_type<T> parse(std::pmr::memory_resource *resource,
+                                          int argc, const char **argv) const {
+    detail::ResourceScope const scope(resource);
+    return parse(argc, argv);
+  }
+
+  // Parse argc/argv, keeping any response files it refers to mapped in
+  // mapped_files (rather than for the rest of the program)
+  detail::parse_args_return_type<T> parse(int argc, const char **argv,
+                                          MappedFiles &mapped_files) const {
+    detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                          prototype);
+    detail::parse_args(val, schema, argc, argv, &mapped_files);
+    return val;
+  }
+
+  // See ParseArgStream
+  detail::parse_args_return_type<T> parse_stream(int fd,
+                                                 std::span<char> buffer) const {
+    detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                          prototype);
+    detail::ArgStream stream(fd, buffer);
+    detail::parse_stream(val, schema, stream);
+    return val;
+  }
+
+  // See ParseConfig, the config file is kept mapped in mapped_files
+  detail::parse_args_return_type<T>
+  parse_config(const char *path, MappedFiles &mapped_files) const {
+    detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                          prototype);
+    detail::parse_config_only(val, schema, path, &mapped_files);
+    return val;
+  }
+
+  // See ParseArgsWithConfig, the files we read are kept mapped in mapped_files
+  detail::parse_args_return_type<T>
+  parse_with_config(const char *config_path, int argc, const char **argv,
+                    MappedFiles &mapped_files) const {
+    detail::parse_args_return_type<T> val(std::in_place_type_t<T>{},
+                                          prototype);
+    detail::parse_args(val, schema, argc, argv, &mapped_files, config_path);
+    return val;
+  }
+
+  // Parse every argv in batch, spread over thread_count threads (0 means one
+  // per hardware thread). Results are returned in the same order as batch, and
+  // each holds its own error, so one bad command line does not stop the rest.
+  std::vector<detail::parse_args_return_type<T>>
+  parse_batch(std::span<std::span<const char *> const> batch,
+              unsigned thread_count = 0) const {
+    // Every slot is overwritten before we return, UsageError is just a cheap
+    // placeholder that does not need a T
+    std::vector<detail::parse_args_return_type<T>> results(
+        batch.size(), detail::parse_args_return_type<T>(UsageError{}));
+    auto parse_range = [this, &batch, &results](size_t first, size_t last) {
+      for (size_t i = first; i < last; i++) {
+        results[i] = parse(static_cast<int>(batch[i].size()), batch[i].data());
+      }
+    };
+    if (thread_count == 0) {
+      thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Hand out work in chunks so that threads stay busy even when some command
+    // lines are much longer than others
+    constexpr size_t chunk_size = 64;
+    auto const chunks = (batch.size() + chunk_size - 1) / chunk_size;
+    thread_count = static_cast<unsigned>(
+        std::min<size_t>(thread_count, std::max<size_t>(chunks, 1)));
+    std::atomic<size_t> next_chunk = 0;
+    auto worker = [&] {
+      for (size_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++) {
+        parse_range(chunk * chunk_size,
+                    std::min(batch.size(), (chunk + 1) * chunk_size));
+      }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (unsigned i = 1; i < thread_count; i++) {
+      threads.emplace_back(worker);
+    }
+    // The calling thread does its share of the work too
+    worker();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    return results;
+  }
+
+private:
+  T prototype;
+  detail::Schema<T> const &schema;
+};
+
+// Write a message for err, from a parse into a T, to [first, last) in the style
+// of std::to_chars (ex: invalid value for --port: "abc" (argument 2)). Errors
+// only carry indices and pointers, so nothing is built until this is called.
+// The value in err points into what was parsed, so this has to be called while
+// that (argv, or a MappedFiles) is still alive. For subcommands, pass the type
+// of the command that was picked. T is default constructed to look up its
+// member names.
+template <class T>
+  requires(!detail::is_variant<T>::value)
+std::to_chars_result FormatError(char *first, char *last,
+                                 ErrorInfo const &err) {
+  detail::ErrorWriter out{first, last};
+  out.append(detail::describe(err.code));
+  using schema_type = detail::Schema<T>;
+  if (err.member >= 0 && static_cast<size_t>(err.member) < schema_type::size) {
+    T inst{};
+    auto const &schema = detail::get_schema(inst);
+    auto const append_member = [&](size_t index) {
+      if (err.code == ErrorCode::BadSchema) {
+        // The member is at fault, not anything that was given for it
+        out.append(schema.names[index]);
+      } else if (schema.options[index].positional) {
+        out.append("<");
+        out.append(schema.names[index]);
+        out.append(">");
+      } else {
+        auto const flag = schema.flag_name(index);
+        out.append(flag.prefix);
+        out.append(flag.name);
+      }
+    };
+    out.append(" for ");
+    if (!err.missing.any()) {
+      append_member(static_cast<size_t>(err.member));
+    }
+    // Name every missing member we have a bit for, and count the rest
+    size_t named = 0;
+    for (size_t w = 0; w < err.missing.words.size(); w++) {
+      for (auto bits = err.missing.words[w]; bits != 0; bits &= bits - 1) {
+        auto const index = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+        if (index >= schema_type::size) {
+          break;
+        }
+        out.append(named++ == 0 ? "" : ", ");
+        append_member(index);
+      }
+    }
+    if (err.missing_count > named) {
+      out.append(" and ");
+      out.append_number(err.missing_count - named);
+      out.append(" more");
+    }
+  }
+  if (err.value != nullptr) {
+    out.append(": \"");
+    out.append(err.value);
+    out.append("\"");
+  }
+  if (err.line != 0) {
+    out.append(" on line ");
+    out.append_number(err.line);
+  }
+  if (err.arg_index >= 0) {
+    out.append(" (argument ");
+    out.append_number(static_cast<size_t>(err.arg_index));
+    out.append(")");
+  }
+  return out.result();
+}
+
+// Parse a whole batch of argv vectors into Ts, in parallel. See
+// Parser<T>::parse_batch.
+template <class T>
+std::vector<detail::parse_args_return_type<T>>
+ParseArgsBatch(std::span<std::span<const char *> const> batch,
+               unsigned thread_count = 0) {
+  return Parser<T>{}.parse_batch(batch, thread_count);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include "mapped_file.hpp"
+
+namespace detail {
+
+// One key = value line of a config file
+struct ConfigEntry {
+  // The [section] the key is in, or empty before the first section
+  std::string_view section;
+  std::string_view key;
+  // Null terminated in place, so that it can be parsed just like an arg
+  const char *value;
+};
+
+// Streams the entries of an INI style config file out of a block of memory
+// (typically a MappedFile), one line at a time, without building anything on
+// the side. Values are null terminated in place, so data must be writable and
+// have one writable byte past size.
+//
+// Lines are key = value pairs, [section] headers, blank, or comments starting
+// with # or ;. Whitespace around keys and values is ignored, and a value may be
+// wrapped in '' or "" to keep whitespace at its ends.
+class ConfigReader {
+public:
+  enum class Status {
+    Entry,
+    End,
+    // A line that is none of the above, see line()
+    Error,
+  };
+
+  ConfigReader(char *data, size_t size) : pos(data), end(data + size) {}
+
+  Status next(ConfigEntry &entry) {
+    while (pos != end) {
+      char *line_begin = pos;
+      auto *newline =
+          static_cast<char *>(std::memchr(pos, '\n', end - line_begin));
+      char *line_end = newline != nullptr ? newline : end;
+      pos = newline != nullptr ? newline + 1 : end;
+      line_++;
+
+      std::string_view line = trim(line_begin, line_end);
+      if (line.empty() || line.front() == '#' || line.front() == ';') {
+        continue;
+      }
+      if (line.front() == '[') {
+        if (line.back() != ']') {
+          return Status::Error;
+        }
+        line.remove_prefix(1);
+        line.remove_suffix(1);
+        section = trim(line);
+        continue;
+      }
+      auto const eq = line.find('=');
+      if (eq == std::string_view::npos) {
+        return Status::Error;
+      }
+      entry.section = section;
+      entry.key = trim(line.substr(0, eq));
+      if (entry.key.empty()) {
+        return Status::Error;
+      }
+      std::string_view value = trim(line.substr(eq + 1));
+      bool const quoted = value.size() >= 2 &&
+                          (value.front() == '"' || value.front() == '\'') &&
+                          value.back() == value.front();
+      if (quoted) {
+        value.remove_prefix(1);
+        value.remove_suffix(1);
+      }
+      // The byte after the value is whitespace, a closing quote, the newline,
+      // or the spare byte past the end of data, none of which we need anymore
+      char *value_begin = line_begin + (value.data() - line_begin);
+      value_begin[value.size()] = '\0';
+      entry.value = value_begin;
+      return Status::Entry;
+    }
+    return Status::End;
+  }
+
+  // The line number (from 1) of the line we last read
+  size_t line() const { return line_; }
+
+private:
+  static constexpr bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+  static std::string_view trim(std::string_view str) {
+    while (!str.empty() && is_space(str.front())) {
+      str.remove_prefix(1);
+    }
+    while (!str.empty() && is_space(str.back())) {
+      str.remove_suffix(1);
+    }
+    return str;
+  }
+  static std::string_view trim(const char *begin, const char *end) {
+    return trim(std::string_view(begin, end - begin));
+  }
+
+  char *pos;
+  char *end;
+  std::string_view section;
+  size_t line_ = 0;
+};
+
+} // namespace detail
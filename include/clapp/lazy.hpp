@@ -0,0 +1,121 @@
+#pragma once
+#include "clapp.hpp"
+#include <cassert>
+#include <charconv>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// A member whose ArgParse<T> is only run the first time it is read, for types
+// that are expensive to convert and often go unused. While parsing, we only
+// remember the arg the value comes from (and run ArgParse<T>::Validate on it,
+// if there is one), so Lazy<T> is for types that are parsed from exactly one
+// arg.
+// LIFETIME: like std::string_view members, the arg is not copied, so a Lazy<T>
+// must be read while the args it was parsed from are still alive.
+// NOTE: Reading a Lazy<T> for the first time writes its cached value, so it
+// should not be read from many threads at once until it has been read once.
+template <class T> class Lazy {
+public:
+  // Holds a value-initialized T until an arg is parsed into it
+  Lazy() = default;
+  // Holds value (ex: a default) until an arg is parsed into it
+  Lazy(T val) : value(std::move(val)) {}
+
+  // Defer parsing arg until we are first read
+  static Lazy from_arg(const char *arg) {
+    Lazy lazy;
+    lazy.pending = arg;
+    lazy.arg = arg;
+    return lazy;
+  }
+
+  // The parsed value, or the ParseError from parsing it. The arg is parsed the
+  // first time this is called, and the result is kept for every call after.
+  // Errors point at the arg (see FormatError), but not at where it was in
+  // argv, which is not known by the time we are read.
+  ArgParseReturnT<T> const &get() const {
+    if (pending != nullptr) {
+      const char *args[] = {pending};
+      const char **begin = args;
+      value = ArgParse<T>::Parse(begin, std::end(args));
+      if (value.index() == 0 && begin != std::end(args)) {
+        // T did not take exactly the one arg we have for it
+        value.template emplace<ParseError>();
+      }
+      if (auto *err = std::get_if<ParseError>(&value)) {
+        // Like a parse does, keep a code the ArgParse gave over ours
+        if (err->code == ErrorCode::Unknown) {
+          err->code = ErrorCode::InvalidValue;
+        }
+        err->value = pending;
+      }
+      pending = nullptr;
+    }
+    return value;
+  }
+
+  bool has_value() const { return get().index() == 0; }
+
+  // Only valid if has_value()
+  T const &operator*() const {
+    assert(has_value());
+    return std::get<0>(get());
+  }
+  T const *operator->() const { return &**this; }
+
+  // The arg this was parsed from, or null if it was not parsed from an arg. Is
+  // still set after reading, so that a ParseError can be reported with it.
+  const char *source() const { return arg; }
+
+private:
+  mutable ArgParseReturnT<T> value{};
+  mutable const char *pending = nullptr;
+  const char *arg = nullptr;
+};
+
+namespace detail {
+
+// ArgParse<T>::Validate is an optional cheap check of an arg, that Lazy<T>
+// runs while parsing so that obviously bad args are still reported up front
+template <class T>
+concept has_validate = requires(const char *arg) {
+  { ArgParse<T>::Validate(arg) } -> std::convertible_to<bool>;
+};
+
+} // namespace detail
+
+template <class T> struct ArgParse<Lazy<T>> {
+  static ArgParseReturnT<Lazy<T>> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      // We need a string to defer
+      return ParseError{};
+    }
+    const char *arg = *begin;
+    if constexpr (detail::has_validate<T>) {
+      if (!ArgParse<T>::Validate(arg)) {
+        return ParseError{};
+      }
+    }
+    begin++;
+    return Lazy<T>::from_arg(arg);
+  }
+  // Only values that did not come from an arg (ex: defaults) are printed, so
+  // that printing never runs a deferred parse
+  static std::to_chars_result Format(char *first, char *last,
+                                     Lazy<T> const &value)
+    requires detail::has_format<T>
+  {
+    if (value.source() != nullptr || !value.has_value()) {
+      return {first, std::errc::invalid_argument};
+    }
+    return ArgParse<T>::Format(first, last, *value);
+  }
+  static void Complete(std::string_view word, auto &&add)
+    requires detail::has_complete<T>
+  {
+    ArgParse<T>::Complete(word, add);
+  }
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace detail {
+
+// A private, writable mapping of a whole file. Writes never reach the file, so
+// we are free to tokenize it in place. There is always one spare byte mapped
+// past the end of the file, so that the last token can be null terminated.
+class MappedFile {
+public:
+  static std::optional<MappedFile> open(const char *path) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      ::close(fd);
+      return std::nullopt;
+    }
+    auto const size = static_cast<size_t>(st.st_size);
+    // Reserve the spare byte with an anonymous mapping first, then map the
+    // file over the front of it. Bytes past the end of the file in its last
+    // page read as zero, and if the file ends on a page boundary the spare
+    // byte is in the anonymous page after it.
+    auto const length = size + 1;
+    void *base = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      ::close(fd);
+      return std::nullopt;
+    }
+    if (size != 0 && mmap(base, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+      munmap(base, length);
+      ::close(fd);
+      return std::nullopt;
+    }
+    // The mapping keeps the file alive on its own
+    ::close(fd);
+    return MappedFile(static_cast<char *>(base), size);
+  }
+
+  MappedFile(MappedFile &&other) noexcept
+      : base(std::exchange(other.base, nullptr)), size_(other.size_) {}
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    std::swap(base, other.base);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+  ~MappedFile() {
+    if (base != nullptr) {
+      munmap(base, size_ + 1);
+    }
+  }
+
+  char *data() const { return base; }
+  size_t size() const { return size_; }
+
+  // Leave the file mapped for the rest of the program
+  void release() { base = nullptr; }
+
+private:
+  MappedFile(char *base, size_t size) : base(base), size_(size) {}
+
+  char *base;
+  size_t size_;
+};
+
+// Walks a block of back to back null terminated tokens, ex: "a\0bc\0d\0".
+// Dereferences to the current token, just like a const char ** into argv does.
+class NulTokenIterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = const char *;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const char *const *;
+  using reference = const char *const &;
+
+  NulTokenIterator() = default;
+  explicit NulTokenIterator(const char *ptr) : ptr(ptr) {}
+
+  reference operator*() const { return ptr; }
+  NulTokenIterator &operator++() {
+    ptr += std::strlen(ptr) + 1;
+    return *this;
+  }
+  NulTokenIterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+  bool operator==(NulTokenIterator const &) const = default;
+
+private:
+  const char *ptr = nullptr;
+};
+
+constexpr bool is_token_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+// Tokenize the size bytes at data in place, packing the tokens back to back
+// (each null terminated) at the front of data, and return the end of the
+// packed tokens. data must have one writable byte past size.
+// If the file has any null bytes, it is taken to be null delimited already
+// (like xargs -0 or find -print0), otherwise tokens are separated by
+// whitespace, and may be quoted with '' or "" or escaped with \ like a shell.
+inline char *tokenize_in_place(char *data, size_t size) {
+  char *const end = data + size;
+  if (std::memchr(data, '\0', size) != nullptr) {
+    // Already packed, we just need to terminate the last token
+    if (data[size - 1] != '\0') {
+      *end = '\0';
+      return end + 1;
+    }
+    return end;
+  }
+  // We only ever write a token at or before where we read it from, so we never
+  // clobber input we haven't seen yet
+  char *out = data;
+  char *in = data;
+  while (true) {
+    while (in != end && is_token_space(*in)) {
+      in++;
+    }
+    if (in == end) {
+      break;
+    }
+    char quote = '\0';
+    while (in != end) {
+      char c = *in;
+      if (quote != '\0') {
+        if (c == quote) {
+          quote = '\0';
+          in++;
+          continue;
+        }
+        // Inside double quotes, only quotes and backslashes can be escaped
+        if (quote == '"' && c == '\\' && in + 1 != end &&
+            (in[1] == '"' || in[1] == '\\')) {
+          c = *++in;
+        }
+      } else if (is_token_space(c)) {
+        break;
+      } else if (c == '\'' || c == '"') {
+        quote = c;
+        in++;
+        continue;
+      } else if (c == '\\' && in + 1 != end) {
+        c = *++in;
+      }
+      *out++ = c;
+      in++;
+    }
+    // Step over the separator before we (maybe) overwrite it
+    if (in != end) {
+      in++;
+    }
+    *out++ = '\0';
+  }
+  return out;
+}
+
+} // namespace detail
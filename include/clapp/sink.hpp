@@ -0,0 +1,62 @@
+#pragma once
+#include "clapp.hpp"
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// A positional that takes any number of args, and hands each one (parsed with
+// ArgParse<T>) to callback as soon as it is parsed, rather than keeping them.
+// It takes every positional after the other positionals, so a parse uses the
+// same memory however many args it is given, ex: for the file names from
+// find -print0 (see ParseArgStream). If callback returns a bool, returning
+// false fails the parse at that arg.
+// LIFETIME: values are passed on as they are parsed, so a T that views its arg
+// (ex: std::string_view) is only valid for as long as the args are. For a
+// streamed parse, that is only until callback returns.
+template <class F, class T = std::string_view> class Sink {
+public:
+  Sink() = default;
+  template <class G>
+    requires std::constructible_from<F, G>
+  Sink(G &&callback) : callback(std::forward<G>(callback)) {}
+
+  // Hand value on to callback, returning false if it rejected it
+  bool operator()(T value) {
+    count_++;
+    if constexpr (std::is_convertible_v<std::invoke_result_t<F &, T>, bool>) {
+      return static_cast<bool>(callback(std::move(value)));
+    } else {
+      callback(std::move(value));
+      return true;
+    }
+  }
+
+  // How many values have been handed to callback
+  size_t count() const { return count_; }
+
+private:
+  F callback{};
+  size_t count_ = 0;
+};
+
+template <class F, class T> struct ArgParse<Sink<F, T>> {
+  static std::optional<ParseError> ParseInto(Sink<F, T> &sink, auto &begin,
+                                             auto const end) {
+    auto value = ArgParse<T>::Parse(begin, end);
+    if (value.index() != 0) {
+      return std::get<1>(std::move(value));
+    }
+    if (!sink(std::get<0>(std::move(value)))) {
+      return ParseError{{.code = ErrorCode::InvalidValue}};
+    }
+    return std::nullopt;
+  }
+  static void Complete(std::string_view word, auto &&add)
+    requires detail::has_complete<T>
+  {
+    ArgParse<T>::Complete(word, add);
+  }
+};
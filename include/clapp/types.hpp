@@ -1,25 +1,379 @@
 #pragma once
 #include "clapp.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstdio>
 #include <cstdlib>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
+#include <vector>
+
+namespace detail {
+
+// The longest number (after removing digit separators) we will parse
+constexpr size_t max_number_size = 256;
+
+// Characters that may be used to group digits, ex: 1'000'000 or 0xffff_ffff
+constexpr bool is_digit_separator(char c) { return c == '\'' || c == '_'; }
+
+// Split off a leading sign, returning true if it was negative
+constexpr bool consume_sign(std::string_view &str) {
+  if (!str.empty() && (str.front() == '-' || str.front() == '+')) {
+    bool const negative = str.front() == '-';
+    str.remove_prefix(1);
+    return negative;
+  }
+  return false;
+}
+
+// Split off a base prefix (0x, 0o, 0b or a C style leading 0 for octal),
+// returning the base to parse the rest of str with
+constexpr int consume_base_prefix(std::string_view &str) {
+  if (str.size() > 2 && str[0] == '0') {
+    switch (str[1]) {
+    case 'x':
+    case 'X':
+      str.remove_prefix(2);
+      return 16;
+    case 'o':
+    case 'O':
+      str.remove_prefix(2);
+      return 8;
+    case 'b':
+    case 'B':
+      str.remove_prefix(2);
+      return 2;
+    }
+  }
+  if (str.size() > 1 && str[0] == '0') {
+    str.remove_prefix(1);
+    return 8;
+  }
+  return 10;
+}
+
+// The value of the digit c in base, or base if it is not one
+constexpr unsigned digit_value(char c, unsigned base) {
+  unsigned value = base;
+  if (c >= '0' && c <= '9') {
+    value = static_cast<unsigned>(c - '0');
+  } else if (c >= 'a' && c <= 'z') {
+    value = static_cast<unsigned>(c - 'a' + 10);
+  } else if (c >= 'A' && c <= 'Z') {
+    value = static_cast<unsigned>(c - 'A' + 10);
+  }
+  return value < base ? value : base;
+}
+
+// If str (the digits of a number in base, after its sign and prefix) has digit
+// separators, copy it into buf without them and return the copy. A separator
+// must sit between two digits, otherwise we fail.
+constexpr std::optional<std::string_view>
+strip_digit_separators(std::string_view str, unsigned base,
+                       std::array<char, max_number_size> &buf) {
+  if (std::none_of(str.begin(), str.end(), is_digit_separator)) {
+    return str;
+  }
+  if (str.size() > buf.size()) {
+    return std::nullopt;
+  }
+  auto const is_digit = [base](char c) { return digit_value(c, base) < base; };
+  size_t size = 0;
+  for (size_t i = 0; i < str.size(); i++) {
+    if (is_digit_separator(str[i])) {
+      if (i == 0 || i + 1 == str.size() || !is_digit(str[i - 1]) ||
+          !is_digit(str[i + 1])) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    buf[size++] = str[i];
+  }
+  return std::string_view(buf.data(), size);
+}
+
+// std::from_chars for an unsigned magnitude, for constant evaluation (where
+// from_chars cannot be used until C++23). Fails unless all of str is digits
+// and the value fits in U.
+template <class U>
+constexpr bool parse_magnitude(std::string_view str, unsigned base,
+                               U &magnitude) {
+  U value{};
+  for (char c : str) {
+    auto const digit = digit_value(c, base);
+    if (digit == base ||
+        value > (std::numeric_limits<U>::max() - digit) / base) {
+      return false;
+    }
+    value = static_cast<U>(value * base + digit);
+  }
+  magnitude = value;
+  return true;
+}
+
+template <class T>
+constexpr std::optional<T> parse_integer(std::string_view str) {
+  bool const negative = consume_sign(str);
+  int const base = consume_base_prefix(str);
+  // A sign after the prefix has already been handled (or is garbage)
+  if (str.empty() || str.front() == '-' || str.front() == '+') {
+    return std::nullopt;
+  }
+  std::array<char, max_number_size> buf;
+  auto stripped =
+      strip_digit_separators(str, static_cast<unsigned>(base), buf);
+  if (!stripped) {
+    return std::nullopt;
+  }
+  str = *stripped;
+  // Parse the magnitude unsigned so that we can range check it ourselves
+  // against T, rather than against some larger type
+  using unsigned_type = std::make_unsigned_t<T>;
+  unsigned_type magnitude{};
+  if (std::is_constant_evaluated()) {
+    if (!parse_magnitude(str, static_cast<unsigned>(base), magnitude)) {
+      return std::nullopt;
+    }
+  } else {
+    auto const [ptr, ec] =
+        std::from_chars(str.data(), str.data() + str.size(), magnitude, base);
+    if (ec != std::errc{} || ptr != str.data() + str.size()) {
+      return std::nullopt;
+    }
+  }
+  auto const max = static_cast<unsigned_type>(std::numeric_limits<T>::max());
+  if (!negative) {
+    if (magnitude > max) {
+      return std::nullopt;
+    }
+    return static_cast<T>(magnitude);
+  }
+  if constexpr (std::is_unsigned_v<T>) {
+    // Only -0 is representable
+    if (magnitude != 0) {
+      return std::nullopt;
+    }
+    return T{};
+  } else {
+    // The magnitude of min() is one past max()
+    if (magnitude > max + 1u) {
+      return std::nullopt;
+    }
+    // Negate in the unsigned type (which wraps) to avoid overflowing on min()
+    return static_cast<T>(static_cast<unsigned_type>(0u - magnitude));
+  }
+}
+
+template <class T> std::optional<T> parse_floating(std::string_view str) {
+  bool const negative = consume_sign(str);
+  if (str.empty() || str.front() == '-' || str.front() == '+') {
+    return std::nullopt;
+  }
+  bool const hex =
+      str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X');
+  std::array<char, max_number_size> buf;
+  auto stripped = strip_digit_separators(str, hex ? 16 : 10, buf);
+  if (!stripped) {
+    return std::nullopt;
+  }
+  str = *stripped;
+  T value{};
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  auto format = std::chars_format::general;
+  if (hex) {
+    // from_chars wants hex floats without their prefix
+    str.remove_prefix(2);
+    format = std::chars_format::hex;
+  }
+  auto const [ptr, ec] =
+      std::from_chars(str.data(), str.data() + str.size(), value, format);
+  if (ec != std::errc{} || ptr != str.data() + str.size()) {
+    return std::nullopt;
+  }
+#else
+  // No floating point from_chars in this standard library, fall back to the
+  // (locale dependent) strto* family, which needs a null terminated copy
+  if (str.size() >= buf.size()) {
+    return std::nullopt;
+  }
+  std::array<char, max_number_size> terminated;
+  std::copy(str.begin(), str.end(), terminated.begin());
+  terminated[str.size()] = '\0';
+  char *end_ptr;
+  errno = 0;
+  if constexpr (std::is_same_v<T, float>) {
+    value = std::strtof(terminated.data(), &end_ptr);
+  } else if constexpr (std::is_same_v<T, double>) {
+    value = std::strtod(terminated.data(), &end_ptr);
+  } else {
+    value = std::strtold(terminated.data(), &end_ptr);
+  }
+  if (errno != 0 || end_ptr != terminated.data() + str.size()) {
+    return std::nullopt;
+  }
+#endif
+  return negative ? -value : value;
+}
+
+// Print str wrapped in quotes, or fail if it is empty (and not worth printing)
+inline std::to_chars_result format_string(char *first, char *last,
+                                          std::string_view str) {
+  if (str.empty()) {
+    return {first, std::errc::invalid_argument};
+  }
+  if (static_cast<size_t>(last - first) < str.size() + 2) {
+    return {last, std::errc::value_too_large};
+  }
+  *first++ = '"';
+  first = std::copy(str.begin(), str.end(), first);
+  *first++ = '"';
+  return {first, std::errc{}};
+}
+
+// If arg is the start of another flag (or "--"), rather than a value. "-" on
+// its own and negative numbers (-1, -.5) are values.
+constexpr bool is_flag_like(std::string_view arg) {
+  return arg.size() > 1 && arg[0] == '-' &&
+         !(arg[1] >= '0' && arg[1] <= '9') && arg[1] != '.';
+}
+
+} // namespace detail
 
 // Implementations of some common types
+
+// Integers, with an optional sign, an optional 0x/0o/0b (or leading 0 for
+// octal) prefix, and optional ' or _ digit separators. Values that do not fit
+// in T are a ParseError rather than being truncated.
 template <class T>
-  requires(std::is_same_v<T, long> || std::is_same_v<T, int> ||
-           std::is_same_v<T, short> || std::is_same_v<T, char>)
+  requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
 struct ArgParse<T> {
-  static ArgParseReturnT<T> Parse(auto &begin, auto const end) {
+  static constexpr ArgParseReturnT<T> Parse(auto &begin, auto const end) {
     if (begin == end) {
       // We need a string to read
       return ParseError{};
     }
     // Try to parse the integer from the value(s)
-    auto ptr = *begin++;
-    char *end_ptr;
-    auto v = std::strtol(ptr, &end_ptr, 0);
-    if (errno == 0 && *end_ptr == '\0') {
-      return static_cast<T>(v);
+    if (auto v = detail::parse_integer<T>(*begin)) {
+      begin++;
+      return *v;
+    }
+    return ParseError{};
+  }
+  static std::to_chars_result Format(char *first, char *last, T const &value) {
+    return std::to_chars(first, last, value);
+  }
+};
+
+// Floating point numbers, in decimal or 0x prefixed hex, with optional digit
+// separators
+template <std::floating_point T> struct ArgParse<T> {
+  static ArgParseReturnT<T> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      // We need a string to read
+      return ParseError{};
+    }
+    if (auto v = detail::parse_floating<T>(*begin)) {
+      begin++;
+      return *v;
     }
     return ParseError{};
   }
-};
\ No newline at end of file
+  static std::to_chars_result Format(char *first, char *last, T const &value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    return std::to_chars(first, last, value);
+#else
+    int const n = snprintf(first, last - first, "%Lg",
+                           static_cast<long double>(value));
+    if (n < 0 || n >= last - first) {
+      return {last, std::errc::value_too_large};
+    }
+    return {first + n, std::errc{}};
+#endif
+  }
+};
+
+// Strings that refer straight to the arg they were parsed from, without a copy.
+// LIFETIME: these point into the storage of the args that were parsed (argv
+// for ParseArgs), so they are only valid for as long as that storage is. argv
+// itself lives for the whole program, so views parsed from main's argv are
+// always safe to keep.
+template <class T>
+  requires(std::is_same_v<T, std::string_view> ||
+           std::is_same_v<T, const char *>)
+struct ArgParse<T> {
+  static constexpr ArgParseReturnT<T> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      // We need a string to read
+      return ParseError{};
+    }
+    return T(*begin++);
+  }
+  static std::to_chars_result Format(char *first, char *last, T const &value) {
+    if constexpr (std::is_same_v<T, const char *>) {
+      if (value == nullptr) {
+        return {first, std::errc::invalid_argument};
+      }
+    }
+    return detail::format_string(first, last, value);
+  }
+};
+
+// An owned copy of the arg, for when it needs to outlive the args it came from
+template <> struct ArgParse<std::string> {
+  static ArgParseReturnT<std::string> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      // We need a string to read
+      return ParseError{};
+    }
+    return std::string(*begin++);
+  }
+  static std::to_chars_result Format(char *first, char *last,
+                                     std::string const &value) {
+    return detail::format_string(first, last, value);
+  }
+};
+
+// An owned copy of the arg, allocated from ParseResource()
+template <> struct ArgParse<std::pmr::string> {
+  static ArgParseReturnT<std::pmr::string> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      // We need a string to read
+      return ParseError{};
+    }
+    return std::pmr::string(*begin++, ParseResource());
+  }
+  static std::to_chars_result Format(char *first, char *last,
+                                     std::pmr::string const &value) {
+    return detail::format_string(first, last, value);
+  }
+};
+
+// Every value after the flag, up to the next flag (or "--", or the end of the
+// args), ex: --hosts a b c. There has to be at least one. The vector (and its
+// elements, if they are std::pmr types) is allocated from ParseResource().
+template <class T> struct ArgParse<std::pmr::vector<T>> {
+  static ArgParseReturnT<std::pmr::vector<T>> Parse(auto &begin,
+                                                    auto const end) {
+    if (begin == end || detail::is_flag_like(*begin)) {
+      // We need at least one value
+      return ParseError{{.code = ErrorCode::MissingValue}};
+    }
+    std::pmr::vector<T> values(ParseResource());
+    while (begin != end && !detail::is_flag_like(*begin)) {
+      auto value = ArgParse<T>::Parse(begin, end);
+      if (value.index() != 0) {
+        return std::get<1>(std::move(value));
+      }
+      values.push_back(std::get<0>(std::move(value)));
+    }
+    return values;
+  }
+};
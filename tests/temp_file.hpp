@@ -0,0 +1,29 @@
+#pragma once
+#include "gtest/gtest.h"
+#include <string>
+#include <string_view>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+// A temporary file holding contents, removed when we are done with it (even
+// if a test returns early from a failed ASSERT)
+struct TempFile {
+  explicit TempFile(std::string_view contents) {
+    char name[] = "/tmp/clapp_test_XXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(write(fd, contents.data(), contents.size()),
+              static_cast<ssize_t>(contents.size()));
+    close(fd);
+    path = name;
+    arg = "@" + path;
+  }
+  ~TempFile() { unlink(path.c_str()); }
+  TempFile(TempFile const &) = delete;
+  TempFile &operator=(TempFile const &) = delete;
+
+  std::string path;
+  // The @path arg that refers to this file, as a response file
+  std::string arg;
+};
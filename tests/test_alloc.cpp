@@ -0,0 +1,154 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <cstdlib>
+#include <new>
+
+#include <variant>
+
+// Count every global allocation made while counting is set, so that we can
+// assert ParseArgs never touches the heap
+namespace {
+bool counting = false;
+std::size_t allocations = 0;
+
+template <class F> std::size_t CountAllocations(F &&f) {
+  allocations = 0;
+  counting = true;
+  std::forward<F>(f)();
+  counting = false;
+  return allocations;
+}
+} // namespace
+
+void *operator new(std::size_t size) {
+  if (counting) {
+    allocations++;
+  }
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+struct SuperSimple {
+  int flag;
+};
+
+template <> struct MetaInfo<SuperSimple> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+};
+
+struct Rename {
+  int flag;
+  Options __flag{.name = "--a-flag-name-longer-than-any-small-string"};
+};
+
+struct Positional {
+  int positional;
+  Options __positional{.positional = true};
+};
+
+TEST(Alloc, SingleFlag) {
+  std::array args{"filename", "--flag", "10"};
+  detail::parse_args_return_type<SuperSimple> v;
+  EXPECT_EQ(CountAllocations([&] {
+              v = ParseArgs<SuperSimple>(args.size(), args.data());
+            }),
+            0);
+  EXPECT_EQ(std::get<SuperSimple>(v).flag, 10);
+}
+
+TEST(Alloc, InlineValue) {
+  std::array args{"filename", "--flag=10"};
+  detail::parse_args_return_type<SuperSimple> v;
+  EXPECT_EQ(CountAllocations([&] {
+              v = ParseArgs<SuperSimple>(args.size(), args.data());
+            }),
+            0);
+  EXPECT_EQ(std::get<SuperSimple>(v).flag, 10);
+}
+
+TEST(Alloc, Errors) {
+  std::array extra{"filename", "garbage", "--flag", "10"};
+  std::array missing{"filename", "--flag"};
+  std::array bad{"filename", "--flag", "not an int"};
+  EXPECT_EQ(CountAllocations([&] {
+              ParseArgs<SuperSimple>(extra.size(), extra.data());
+              ParseArgs<SuperSimple>(missing.size(), missing.data());
+              ParseArgs<SuperSimple>(bad.size(), bad.data());
+            }),
+            0);
+}
+
+TEST(Alloc, Rename) {
+  std::array args{"filename", "--a-flag-name-longer-than-any-small-string",
+                  "10"};
+  detail::parse_args_return_type<Rename> v;
+  EXPECT_EQ(CountAllocations(
+                [&] { v = ParseArgs<Rename>(args.size(), args.data()); }),
+            0);
+  EXPECT_EQ(std::get<Rename>(v).flag, 10);
+}
+
+TEST(Alloc, Positional) {
+  std::array args{"filename", "10"};
+  std::array missing{"filename"};
+  std::array bad{"filename", "notanint"};
+  detail::parse_args_return_type<Positional> v;
+  EXPECT_EQ(CountAllocations([&] {
+              v = ParseArgs<Positional>(args.size(), args.data());
+              ParseArgs<Positional>(missing.size(), missing.data());
+              ParseArgs<Positional>(bad.size(), bad.data());
+            }),
+            0);
+  EXPECT_EQ(std::get<Positional>(v).positional, 10);
+}
+
+struct Views {
+  std::string_view view;
+  const char *pointer;
+  std::string_view path;
+  Options __path{.positional = true};
+};
+
+TEST(Alloc, Views) {
+  std::array args{"filename", "--view", "a", "--pointer", "b", "/some/path"};
+  EXPECT_EQ(CountAllocations(
+                [&] { ParseArgs<Views>(args.size(), args.data()); }),
+            0);
+}
+
+struct Group {
+  int size;
+  std::string_view name;
+};
+
+struct Grouped {
+  int flag;
+  Group group;
+};
+
+TEST(Alloc, Groups) {
+  // group.member names are spelled out once, without allocating
+  std::array args{"filename", "--group.size", "10", "--group.name", "a"};
+  detail::parse_args_return_type<Grouped> v;
+  EXPECT_EQ(CountAllocations(
+                [&] { v = ParseArgs<Grouped>(args.size(), args.data()); }),
+            0);
+  EXPECT_EQ(std::get<Grouped>(v).group.size, 10);
+}
+
+TEST(Alloc, Help) {
+  std::array args{"filename", "--help"};
+  testing::internal::CaptureStdout();
+  auto count = CountAllocations(
+      [&] { ParseArgs<Positional>(args.size(), args.data()); });
+  testing::internal::GetCapturedStdout();
+  EXPECT_EQ(count, 0);
+}
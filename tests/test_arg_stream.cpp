@@ -0,0 +1,124 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+struct Find {
+  int depth;
+  std::string name;
+  long size;
+  std::string root;
+  Options __root{.positional = true};
+};
+
+// A file descriptor to read contents from, as if piped from another program
+int Pipe(std::string_view contents) {
+  std::array<int, 2> fds;
+  EXPECT_EQ(pipe(fds.data()), 0);
+  EXPECT_EQ(write(fds[1], contents.data(), contents.size()),
+            static_cast<ssize_t>(contents.size()));
+  close(fds[1]);
+  return fds[0];
+}
+
+using namespace std::string_view_literals;
+
+TEST(ArgStream, Simple) {
+  int fd = Pipe("--depth\0" "3\0" "/srv\0" "--name\0" "*.log\0"sv);
+  std::array<char, 4096> buffer;
+  auto v = ParseArgStream<Find>(fd, buffer);
+  close(fd);
+  ASSERT_EQ(v.index(), 0);
+  auto const &find = std::get<Find>(v);
+  EXPECT_EQ(find.depth, 3);
+  EXPECT_EQ(find.name, "*.log");
+  EXPECT_EQ(find.root, "/srv");
+}
+
+TEST(ArgStream, SmallBuffer) {
+  // Only an arg or two fit at a time, so flags keep getting split from their
+  // values. The last arg does not have to be terminated.
+  int fd = Pipe("--depth\0" "3\0" "--size=1024\0" "/some/root\0"
+                "--name\0" "a file name"sv);
+  std::array<char, 20> buffer;
+  auto v = ParseArgStream<Find>(fd, buffer);
+  close(fd);
+  ASSERT_EQ(v.index(), 0);
+  auto const &find = std::get<Find>(v);
+  EXPECT_EQ(find.depth, 3);
+  EXPECT_EQ(find.size, 1024);
+  EXPECT_EQ(find.root, "/some/root");
+  EXPECT_EQ(find.name, "a file name");
+}
+
+struct Hosts {
+  std::pmr::vector<std::pmr::string> hosts;
+  int n;
+};
+
+TEST(ArgStream, ValuesSplitAcrossWindows) {
+  // The first window ends after a, so b and c are in the next one
+  int fd = Pipe("--n\0" "5\0" "--hosts\0" "a\0" "b\0" "c\0"sv);
+  std::array<char, 18> buffer;
+  auto v = ParseArgStream<Hosts>(fd, buffer);
+  close(fd);
+  ASSERT_EQ(v.index(), 0);
+  auto const &hosts = std::get<Hosts>(v);
+  EXPECT_EQ(hosts.hosts, (std::pmr::vector<std::pmr::string>{"a", "b", "c"}));
+  EXPECT_EQ(hosts.n, 5);
+
+  // A flag and its values have to fit in one window together
+  int long_fd = Pipe("--hosts\0" "a\0" "b\0" "c\0" "d\0" "e\0"sv);
+  std::array<char, 12> small_buffer;
+  auto l = ParseArgStream<Hosts>(long_fd, small_buffer);
+  close(long_fd);
+  ASSERT_TRUE(std::holds_alternative<ParseError>(l));
+  EXPECT_EQ(std::get<ParseError>(l).code, ErrorCode::ArgTooLong);
+}
+
+TEST(ArgStream, Parser) {
+  Parser<Find> const parser;
+  int fd = Pipe("/srv\0" "--depth\0" "4\0"sv);
+  std::array<char, 12> buffer;
+  auto v = parser.parse_stream(fd, buffer);
+  close(fd);
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Find>(v).depth, 4);
+}
+
+TEST(ArgStream, Errors) {
+  // The index is of the arg in the whole stream, not in its window
+  int fd = Pipe("/srv\0" "--depth\0" "1\0" "--depth\0" "x\0"sv);
+  std::array<char, 12> buffer;
+  auto v = ParseArgStream<Find>(fd, buffer);
+  close(fd);
+  ASSERT_TRUE(std::holds_alternative<ParseError>(v));
+  EXPECT_EQ(std::get<ParseError>(v).code, ErrorCode::InvalidValue);
+  EXPECT_EQ(std::get<ParseError>(v).arg_index, 4);
+
+  int long_fd = Pipe("/srv\0" "--name\0" "longer than the buffer\0"sv);
+  auto l = ParseArgStream<Find>(long_fd, buffer);
+  close(long_fd);
+  ASSERT_TRUE(std::holds_alternative<ParseError>(l));
+  EXPECT_EQ(std::get<ParseError>(l).code, ErrorCode::ArgTooLong);
+
+  // A bad value is reported where it is, even with more args to come
+  int bad_fd = Pipe("--depth\0" "x\0" "/srv\0" "--name\0" "some name\0"sv);
+  auto b = ParseArgStream<Find>(bad_fd, buffer);
+  close(bad_fd);
+  ASSERT_TRUE(std::holds_alternative<ParseError>(b));
+  EXPECT_EQ(std::get<ParseError>(b).code, ErrorCode::InvalidValue);
+  EXPECT_EQ(std::get<ParseError>(b).arg_index, 1);
+
+  int missing_fd = Pipe("--depth\0" "2\0"sv);
+  auto m = ParseArgStream<Find>(missing_fd, buffer);
+  close(missing_fd);
+  ASSERT_TRUE(std::holds_alternative<UsageError>(m));
+  EXPECT_EQ(std::get<UsageError>(m).code, ErrorCode::MissingPositional);
+}
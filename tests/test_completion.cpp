@@ -0,0 +1,125 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <variant>
+
+// A type with a fixed set of values, that it offers as completions
+enum class Mode { Debug, Release };
+
+template <> struct ArgParse<Mode> {
+  static ArgParseReturnT<Mode> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      return ParseError{};
+    }
+    std::string_view const str(*begin);
+    if (str != "debug" && str != "release") {
+      return ParseError{};
+    }
+    begin++;
+    return str == "debug" ? Mode::Debug : Mode::Release;
+  }
+  static void Complete(std::string_view, auto &&add) {
+    add("debug");
+    add("release");
+  }
+};
+
+struct Tool {
+  std::string_view host;
+  std::string_view hosts;
+  int port;
+  Mode mode;
+  Mode target;
+  Options __port{.name = "-p"};
+  Options __target{.positional = true};
+};
+
+// Another command, to complete subcommands alongside Tool
+struct Other {
+  int count;
+};
+
+template <> struct MetaInfo<Tool> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  constexpr static std::string_view command_name = "tool";
+  constexpr static std::string_view complete_arg = "--clapp-complete";
+};
+
+template <> struct MetaInfo<Other> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  constexpr static std::string_view command_name = "other";
+  constexpr static std::string_view complete_arg = "--clapp-complete";
+};
+
+using Commands = std::variant<Tool, Other>;
+
+template <> struct MetaInfo<Commands> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  constexpr static std::string_view complete_arg = "--clapp-complete";
+};
+
+// Completion is off unless MetaInfo asks for it
+struct Quiet {
+  int count;
+};
+
+// Ask T for the completions of the last of words
+template <class T, size_t N>
+std::string Complete(std::array<const char *, N> const &words) {
+  std::array<const char *, N + 2> args{"filename", "--clapp-complete"};
+  std::copy(words.begin(), words.end(), args.begin() + 2);
+  testing::internal::CaptureStdout();
+  auto v = ParseArgs<T>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<UsageError>(v));
+  return testing::internal::GetCapturedStdout();
+}
+
+TEST(Completion, Flags) {
+  EXPECT_EQ(Complete<Tool>(std::array{"--ho"}), "--host\n--hosts\n");
+  EXPECT_EQ(Complete<Tool>(std::array{"--hosts"}), "--hosts\n");
+  EXPECT_EQ(Complete<Tool>(std::array{"-"}),
+            "--h\n--help\n--host\n--hosts\n--mode\n-p\n");
+  EXPECT_EQ(Complete<Tool>(std::array{"--x"}), "");
+  // Once the positional is given, an empty word is completed with flags
+  EXPECT_EQ(Complete<Tool>(std::array{"debug", "--port", "1", ""}),
+            "--h\n--help\n--host\n--hosts\n--mode\n-p\n");
+}
+
+TEST(Completion, Values) {
+  EXPECT_EQ(Complete<Tool>(std::array{"--mode", ""}), "debug\nrelease\n");
+  EXPECT_EQ(Complete<Tool>(std::array{"--mode", "r"}), "release\n");
+  EXPECT_EQ(Complete<Tool>(std::array{"--mode=d"}), "--mode=debug\n");
+  // Types without completions have none
+  EXPECT_EQ(Complete<Tool>(std::array{"--host", ""}), "");
+  // Positionals
+  EXPECT_EQ(Complete<Tool>(std::array{"--host", "h", ""}), "debug\nrelease\n");
+  EXPECT_EQ(Complete<Tool>(std::array{"--", "-"}), "");
+}
+
+TEST(Completion, Subcommands) {
+  EXPECT_EQ(Complete<Commands>(std::array{""}), "other\ntool\n");
+  EXPECT_EQ(Complete<Commands>(std::array{"t"}), "tool\n");
+  EXPECT_EQ(Complete<Commands>(std::array{"other", "--c"}), "--count\n");
+  EXPECT_EQ(Complete<Commands>(std::array{"tool", "--mode", ""}),
+            "debug\nrelease\n");
+}
+
+TEST(Completion, OptIn) {
+  // Without a complete_arg, it is just an unknown arg
+  std::array args{"filename", "--clapp-complete", "--count", "3"};
+  testing::internal::CaptureStdout();
+  auto v = ParseArgs<Quiet>(args.size(), args.data());
+  EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Quiet>(v).count, 3);
+}
@@ -0,0 +1,73 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include "temp_file.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <variant>
+
+struct Server {
+  int port;
+  std::string_view host;
+  int workers;
+  std::string_view greeting;
+  Options __workers{.name = "-w"};
+};
+
+template <> struct MetaInfo<Server> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+};
+
+TEST(Config, Simple) {
+  TempFile file("# defaults\n"
+                "port = 80\n"
+                "\n"
+                "  ; also a comment\n"
+                "host=example.com\r\n"
+                "-w = 4\n"
+                "greeting = \"  hello = world  \"");
+  auto v = ParseConfig<Server>(file.path.c_str());
+  ASSERT_EQ(v.index(), 0);
+  auto const &s = std::get<Server>(v);
+  EXPECT_EQ(s.port, 80);
+  EXPECT_EQ(s.host, "example.com");
+  EXPECT_EQ(s.workers, 4);
+  EXPECT_EQ(s.greeting, "  hello = world  ");
+}
+
+TEST(Config, ArgsOverride) {
+  TempFile file("port = 80\nhost = example.com\n");
+  std::array args{"filename", "--port", "8080"};
+  MappedFiles files;
+  auto v = Parser<Server>{}.parse_with_config(file.path.c_str(), args.size(),
+                                              args.data(), files);
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Server>(v).port, 8080);
+  EXPECT_EQ(std::get<Server>(v).host, "example.com");
+  EXPECT_EQ(files.files.size(), 1);
+}
+
+TEST(Config, Errors) {
+  TempFile no_value("port\n");
+  TempFile bad_value("port = eighty\n");
+  TempFile bad_section("[server\nport = 80\n");
+  for (auto const *path : {no_value.path.c_str(), bad_value.path.c_str(),
+                           bad_section.path.c_str(), "/does/not/exist"}) {
+    auto v = ParseConfig<Server>(path);
+    EXPECT_TRUE(std::holds_alternative<ParseError>(v)) << path;
+  }
+}
+
+TEST(Config, UnknownKeys) {
+  TempFile unknown("port = 80\nhelp = 1\n");
+  // Keys in a section are looked up as section.key
+  TempFile section("[server]\nport = 80\n");
+  for (auto const *path : {unknown.path.c_str(), section.path.c_str()}) {
+    auto v = ParseConfig<Server>(path);
+    EXPECT_TRUE(std::holds_alternative<UnknownArgError>(v)) << path;
+  }
+}
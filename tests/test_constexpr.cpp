@@ -0,0 +1,105 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include <variant>
+
+struct Profile {
+  int workers;
+  std::uint16_t port;
+  std::string_view host;
+  const char *name;
+  std::string_view mode;
+  Options __workers{.name = "-w"};
+  Options __mode{.positional = true};
+};
+
+template <> struct MetaInfo<Profile> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static bool response_files = true;
+};
+
+// Parsed entirely at compile time
+constexpr auto fast =
+    ParseArgs<Profile>(std::array{"server", "fast", "-w", "0x10", "--port=8080",
+                                  "--host", "example.com", "--name", "Fast"});
+static_assert(fast.index() == 0);
+static_assert(std::get<Profile>(fast).workers == 16);
+static_assert(std::get<Profile>(fast).port == 8080);
+static_assert(std::get<Profile>(fast).host == "example.com");
+static_assert(std::get<Profile>(fast).mode == "fast");
+
+// Bad profiles are caught at compile time too
+constexpr auto too_big =
+    ParseArgs<Profile>(std::array{"server", "big", "--port", "65536"});
+static_assert(std::get<ParseError>(too_big).code == ErrorCode::InvalidValue);
+static_assert(std::get<ParseError>(too_big).arg_index == 3);
+constexpr auto unknown =
+    ParseArgs<Profile>(std::array{"server", "slow", "--threads", "4"});
+static_assert(std::holds_alternative<UnknownArgError>(unknown));
+constexpr auto missing = ParseArgs<Profile>(std::array{"server", "-w", "1"});
+static_assert(std::get<UsageError>(missing).code ==
+              ErrorCode::MissingPositional);
+constexpr auto help = ParseArgs<Profile>(std::array{"server", "--help"});
+static_assert(std::get<UsageError>(help).code == ErrorCode::Help);
+constexpr auto file = ParseArgs<Profile>(std::array{"server", "@args.txt"});
+static_assert(std::get<ParseError>(file).code == ErrorCode::UnreadableFile);
+
+TEST(Constexpr, SameAtRunTime) {
+  // The same profile parses the same way at run time
+  auto const v = ParseArgs<Profile>(std::array{"server", "fast", "-w", "0x10",
+                                               "--port=8080", "--host",
+                                               "example.com", "--name", "Fast"});
+  ASSERT_EQ(v.index(), 0);
+  auto const &p = std::get<Profile>(v);
+  auto const &c = std::get<Profile>(fast);
+  EXPECT_EQ(p.workers, c.workers);
+  EXPECT_EQ(p.port, c.port);
+  EXPECT_EQ(p.host, c.host);
+  EXPECT_EQ(std::string_view(p.name), std::string_view(c.name));
+  EXPECT_EQ(p.mode, c.mode);
+}
+
+// The constexpr integer parse has to agree with the from_chars one
+template <class T> constexpr bool ParsesTo(const char *arg, T expected) {
+  std::array args{arg};
+  auto begin = args.data();
+  auto v = ArgParse<T>::Parse(begin, args.data() + args.size());
+  return v.index() == 0 && std::get<T>(v) == expected;
+}
+
+template <class T> constexpr bool Fails(const char *arg) {
+  std::array args{arg};
+  auto begin = args.data();
+  return ArgParse<T>::Parse(begin, args.data() + args.size()).index() == 1;
+}
+
+static_assert(ParsesTo<int>("-42", -42));
+static_assert(ParsesTo<int>("1'000", 1000));
+static_assert(ParsesTo<unsigned>("0xffff_ffff", 0xffffffffu));
+static_assert(ParsesTo<std::int8_t>("-128", -128));
+static_assert(ParsesTo<long long>("-9223372036854775808",
+                                  std::numeric_limits<long long>::min()));
+static_assert(ParsesTo<int>("0b101", 5));
+static_assert(ParsesTo<int>("017", 15));
+static_assert(Fails<std::uint8_t>("256"));
+static_assert(Fails<int>("0b2"));
+static_assert(Fails<int>("09"));
+static_assert(Fails<int>("4x"));
+static_assert(Fails<unsigned>("-1"));
+static_assert(Fails<int>("99999999999999999999"));
+
+TEST(Constexpr, Integers) {
+  // The same checks, at run time (through from_chars)
+  EXPECT_TRUE(ParsesTo<int>("-42", -42));
+  EXPECT_TRUE(ParsesTo<unsigned>("0xffff_ffff", 0xffffffffu));
+  EXPECT_TRUE(ParsesTo<int>("017", 15));
+  EXPECT_TRUE(Fails<std::uint8_t>("256"));
+  EXPECT_TRUE(Fails<int>("0b2"));
+  EXPECT_TRUE(Fails<int>("99999999999999999999"));
+}
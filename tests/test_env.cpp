@@ -0,0 +1,106 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <cstdlib>
+#include <string_view>
+
+#include <variant>
+
+// A user type, to check that the environment goes through ArgParse too
+struct Level {
+  int value;
+};
+
+template <> struct ArgParse<Level> {
+  static ArgParseReturnT<Level> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      return ParseError{};
+    }
+    std::string_view const str(*begin);
+    if (str == "low" || str == "high") {
+      begin++;
+      return Level{str == "low" ? 0 : 1};
+    }
+    return ParseError{};
+  }
+};
+
+struct Service {
+  int port;
+  std::string_view host;
+  int workers;
+  Level level;
+  std::string_view config;
+  Options __workers{.env = "WORKERS"};
+  Options __config{.positional = true};
+};
+
+template <> struct MetaInfo<Service> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static std::string_view env_prefix = "APP_";
+};
+
+// Sets the environment variables for a test, and clears them after it
+class Env : public ::testing::Test {
+protected:
+  void SetUp() override {
+    setenv("APP_PORT", "8080", 1);
+    setenv("APP_HOST", "example.com", 1);
+    setenv("WORKERS", "4", 1);
+    setenv("APP_LEVEL", "high", 1);
+    // Positionals never come from the environment
+    setenv("APP_CONFIG", "env.cfg", 1);
+  }
+  void TearDown() override {
+    for (auto const *name :
+         {"APP_PORT", "APP_HOST", "WORKERS", "APP_LEVEL", "APP_CONFIG"}) {
+      unsetenv(name);
+    }
+  }
+};
+
+TEST_F(Env, Fallback) {
+  std::array args{"filename", "app.cfg"};
+  auto v = ParseArgs<Service>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &s = std::get<Service>(v);
+  EXPECT_EQ(s.port, 8080);
+  EXPECT_EQ(s.host, "example.com");
+  EXPECT_EQ(s.workers, 4);
+  EXPECT_EQ(s.level.value, 1);
+  EXPECT_EQ(s.config, "app.cfg");
+}
+
+TEST_F(Env, FlagsWin) {
+  // A flag wins, even over an environment variable that would not parse
+  setenv("APP_PORT", "not a port", 1);
+  std::array args{"filename", "--port", "1", "--workers=2", "app.cfg"};
+  auto v = ParseArgs<Service>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &s = std::get<Service>(v);
+  EXPECT_EQ(s.port, 1);
+  EXPECT_EQ(s.workers, 2);
+  EXPECT_EQ(s.host, "example.com");
+}
+
+TEST_F(Env, BadValue) {
+  setenv("APP_LEVEL", "medium", 1);
+  std::array args{"filename", "app.cfg"};
+  auto v = ParseArgs<Service>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+}
+
+TEST_F(Env, Unset) {
+  unsetenv("APP_PORT");
+  // The explicit name replaces the derived one
+  setenv("APP_WORKERS", "100", 1);
+  std::array args{"filename", "app.cfg"};
+  auto v = ParseArgs<Service>(args.size(), args.data(), Service{.port = 99});
+  unsetenv("APP_WORKERS");
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Service>(v).port, 99);
+  EXPECT_EQ(std::get<Service>(v).workers, 4);
+}
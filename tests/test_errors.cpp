@@ -0,0 +1,213 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include "temp_file.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <stdlib.h>
+#include <variant>
+
+struct Port {
+  int value;
+};
+
+// Says why it failed, rather than returning a bare ParseError
+template <> struct ArgParse<Port> {
+  static ArgParseReturnT<Port> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      return ParseError{{.code = ErrorCode::MissingValue}};
+    }
+    auto v = ArgParse<int>::Parse(begin, end);
+    if (v.index() != 0 || std::get<int>(v) > 65535) {
+      return ParseError{{.code = ErrorCode::InvalidValue}};
+    }
+    return Port{std::get<int>(v)};
+  }
+};
+
+struct Server {
+  int workers;
+  Port port;
+  std::string_view path;
+  Options __workers{.name = "-w"};
+  Options __path{.positional = true};
+};
+
+template <> struct MetaInfo<Server> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+};
+
+// The message FormatError builds for err
+template <class T> std::string Message(ErrorInfo const &err) {
+  std::array<char, 256> buf;
+  auto const [ptr, ec] =
+      FormatError<T>(buf.data(), buf.data() + buf.size(), err);
+  EXPECT_EQ(ec, std::errc{});
+  return std::string(buf.data(), ptr);
+}
+
+template <class E, class V> E const &GetError(V const &v) {
+  EXPECT_TRUE(std::holds_alternative<E>(v));
+  static E const none{};
+  auto const *err = std::get_if<E>(&v);
+  return err != nullptr ? *err : none;
+}
+
+TEST(Errors, InvalidValue) {
+  std::array args{"filename", "/srv", "-w", "many"};
+  auto v = ParseArgs<Server>(args.size(), args.data());
+  auto const &err = GetError<ParseError>(v);
+  EXPECT_EQ(err.code, ErrorCode::InvalidValue);
+  EXPECT_EQ(err.arg_index, 3);
+  EXPECT_EQ(err.member, 0);
+  EXPECT_EQ(err.value, args[3]);
+  EXPECT_EQ(Message<Server>(err),
+            "invalid value for -w: \"many\" (argument 3)");
+}
+
+TEST(Errors, InlineValue) {
+  std::array args{"filename", "--port=99999", "/srv"};
+  auto v = ParseArgs<Server>(args.size(), args.data());
+  auto const &err = GetError<ParseError>(v);
+  EXPECT_EQ(err.code, ErrorCode::InvalidValue);
+  EXPECT_EQ(err.arg_index, 1);
+  EXPECT_EQ(err.member, 1);
+  EXPECT_EQ(Message<Server>(err),
+            "invalid value for --port: \"99999\" (argument 1)");
+}
+
+TEST(Errors, MissingValue) {
+  std::array args{"filename", "/srv", "--port"};
+  auto v = ParseArgs<Server>(args.size(), args.data());
+  auto const &err = GetError<ParseError>(v);
+  EXPECT_EQ(err.code, ErrorCode::MissingValue);
+  EXPECT_EQ(err.arg_index, 2);
+  EXPECT_EQ(err.member, 1);
+  EXPECT_EQ(Message<Server>(err),
+            "missing value for --port (argument 2)");
+}
+
+TEST(Errors, UnknownArg) {
+  std::array args{"filename", "/srv", "--verbose"};
+  auto v = ParseArgs<Server>(args.size(), args.data());
+  auto const &err = GetError<UnknownArgError>(v);
+  EXPECT_EQ(err.code, ErrorCode::UnknownArg);
+  EXPECT_EQ(err.arg_index, 2);
+  EXPECT_EQ(err.member, -1);
+  EXPECT_EQ(Message<Server>(err),
+            "unknown argument: \"--verbose\" (argument 2)");
+}
+
+TEST(Errors, MissingPositional) {
+  std::array args{"filename", "-w", "4"};
+  auto v = ParseArgs<Server>(args.size(), args.data());
+  auto const &err = GetError<UsageError>(v);
+  EXPECT_EQ(err.code, ErrorCode::MissingPositional);
+  EXPECT_EQ(err.arg_index, -1);
+  EXPECT_EQ(err.member, 2);
+  EXPECT_EQ(Message<Server>(err), "missing argument for <path>");
+}
+
+struct EnvServer {
+  int workers;
+  Options __workers{.env = "SERVER_WORKERS"};
+};
+
+TEST(Errors, Environment) {
+  setenv("SERVER_WORKERS", "lots", 1);
+  std::array args{"filename"};
+  auto v = ParseArgs<EnvServer>(args.size(), args.data());
+  auto const &err = GetError<ParseError>(v);
+  EXPECT_EQ(err.code, ErrorCode::InvalidValue);
+  EXPECT_EQ(err.arg_index, -1);
+  EXPECT_EQ(err.member, 0);
+  EXPECT_EQ(err.value, std::string_view("lots"));
+  unsetenv("SERVER_WORKERS");
+}
+
+TEST(Errors, ConfigLine) {
+  TempFile file("# workers\n-w = 2\n\nport = 0x\n");
+  auto v = ParseConfig<Server>(file.path.c_str());
+  auto const &err = GetError<ParseError>(v);
+  EXPECT_EQ(err.code, ErrorCode::InvalidValue);
+  EXPECT_EQ(err.arg_index, -1);
+  EXPECT_EQ(err.member, 1);
+  EXPECT_EQ(err.line, 4);
+  EXPECT_EQ(Message<Server>(err), "invalid value for --port: \"0x\" on line 4");
+}
+
+struct Build {
+  int jobs;
+};
+
+template <> struct MetaInfo<Build> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static std::string_view command_name = "build";
+};
+
+struct Clean {
+  int all;
+};
+
+template <> struct MetaInfo<Clean> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static std::string_view command_name = "clean";
+};
+
+TEST(Errors, Subcommands) {
+  // Indices are into the whole argv, not the command's args
+  std::array args{"filename", "build", "--jobs", "x"};
+  auto v = ParseArgs<std::variant<Build, Clean>>(args.size(), args.data());
+  auto const &err = GetError<ParseError>(v);
+  EXPECT_EQ(err.arg_index, 3);
+  EXPECT_EQ(err.member, 0);
+  EXPECT_EQ(Message<Build>(err),
+            "invalid value for --jobs: \"x\" (argument 3)");
+
+  std::array unknown{"filename", "install"};
+  auto u =
+      ParseArgs<std::variant<Build, Clean>>(unknown.size(), unknown.data());
+  auto const &unknown_err = GetError<UnknownArgError>(u);
+  EXPECT_EQ(unknown_err.code, ErrorCode::UnknownCommand);
+  EXPECT_EQ(unknown_err.arg_index, 1);
+}
+
+struct Misnamed {
+  int port;
+  Options port_options{.required = true};
+};
+
+template <> struct MetaInfo<Misnamed> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+};
+
+TEST(Errors, BadSchema) {
+  // An Options member without the prefix fails the parse rather than aborting
+  std::array args{"filename", "--port", "80"};
+  auto v = ParseArgs<Misnamed>(args.size(), args.data());
+  auto const &err = GetError<UsageError>(v);
+  EXPECT_EQ(err.code, ErrorCode::BadSchema);
+  EXPECT_EQ(err.member, 1);
+  EXPECT_EQ(Message<Misnamed>(err), "bad schema for port_options");
+}
+
+TEST(Errors, Truncated) {
+  std::array args{"filename", "/srv", "--port", "x"};
+  auto v = ParseArgs<Server>(args.size(), args.data());
+  auto const &err = GetError<ParseError>(v);
+  std::array<char, 8> buf;
+  auto const [ptr, ec] =
+      FormatError<Server>(buf.data(), buf.data() + buf.size(), err);
+  EXPECT_EQ(ec, std::errc::value_too_large);
+  EXPECT_EQ(ptr, buf.data() + buf.size());
+}
@@ -0,0 +1,145 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include "temp_file.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <cstdlib>
+#include <variant>
+
+struct Db {
+  std::string_view host;
+  int port = 5432;
+  Options __port{.name = "-P"};
+};
+
+struct Pool {
+  int size = 4;
+  int timeout = 10;
+};
+
+struct Cache {
+  int ttl = 60;
+  Pool pool;
+};
+
+// Groups are flattened into --db.host, --cache.pool.size and so on
+struct Service {
+  std::string_view name;
+  Db db;
+  Cache cache;
+  int workers = 1;
+};
+
+template <> struct MetaInfo<Service> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static std::string_view env_prefix = "SVC_";
+  constexpr static std::string_view complete_arg = "--clapp-complete";
+};
+
+TEST(Groups, Flags) {
+  std::array args{"filename",
+                  "--name",
+                  "api",
+                  "--db.host",
+                  "db.internal",
+                  "-P",
+                  "5433",
+                  "--cache.ttl",
+                  "30",
+                  "--cache.pool.size",
+                  "8",
+                  "--cache.pool.timeout=30",
+                  "--workers",
+                  "4"};
+  auto v = ParseArgs<Service>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &s = std::get<Service>(v);
+  EXPECT_EQ(s.name, "api");
+  EXPECT_EQ(s.db.host, "db.internal");
+  EXPECT_EQ(s.db.port, 5433);
+  EXPECT_EQ(s.cache.ttl, 30);
+  EXPECT_EQ(s.cache.pool.size, 8);
+  EXPECT_EQ(s.cache.pool.timeout, 30);
+  EXPECT_EQ(s.workers, 4);
+}
+
+TEST(Groups, OnlyFullNames) {
+  // Members of groups are only known by their full name
+  std::array args{"filename", "--host", "db.internal"};
+  auto v = ParseArgs<Service>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<UnknownArgError>(v));
+  std::array group{"filename", "--db", "db.internal"};
+  v = ParseArgs<Service>(group.size(), group.data());
+  EXPECT_TRUE(std::holds_alternative<UnknownArgError>(v));
+}
+
+TEST(Groups, Help) {
+  std::array args{"filename", "--help"};
+  testing::internal::CaptureStdout();
+  ParseArgs<Service>(args.size(), args.data());
+  auto out = testing::internal::GetCapturedStdout();
+  EXPECT_NE(out.find("  --db.host <std::string_view>\n"), std::string::npos)
+      << out;
+  EXPECT_NE(out.find("  -P <int>"), std::string::npos) << out;
+  EXPECT_NE(out.find("  --cache.pool.timeout <int>"), std::string::npos)
+      << out;
+}
+
+TEST(Groups, Environment) {
+  setenv("SVC_DB_HOST", "env.internal", 1);
+  setenv("SVC_CACHE_POOL_SIZE", "2", 1);
+  std::array args{"filename"};
+  auto v = ParseArgs<Service>(args.size(), args.data());
+  unsetenv("SVC_DB_HOST");
+  unsetenv("SVC_CACHE_POOL_SIZE");
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Service>(v).db.host, "env.internal");
+  EXPECT_EQ(std::get<Service>(v).cache.pool.size, 2);
+}
+
+TEST(Groups, ConfigSections) {
+  // A [section] is the group its keys are in
+  TempFile file("workers = 2\n"
+                "[db]\n"
+                "host = config.internal\n"
+                "[cache.pool]\n"
+                "size = 3\n");
+  auto v = ParseConfig<Service>(file.path.c_str());
+  ASSERT_EQ(v.index(), 0);
+  auto const &s = std::get<Service>(v);
+  EXPECT_EQ(s.workers, 2);
+  EXPECT_EQ(s.db.host, "config.internal");
+  EXPECT_EQ(s.cache.pool.size, 3);
+}
+
+TEST(Groups, Completion) {
+  std::array args{"filename", "--clapp-complete", "--cache.p"};
+  testing::internal::CaptureStdout();
+  ParseArgs<Service>(args.size(), args.data());
+  EXPECT_EQ(testing::internal::GetCapturedStdout(),
+            "--cache.pool.size\n--cache.pool.timeout\n");
+}
+
+TEST(Groups, Errors) {
+  std::array args{"filename", "--cache.pool.size", "many"};
+  auto v = ParseArgs<Service>(args.size(), args.data());
+  auto const *err = std::get_if<ParseError>(&v);
+  ASSERT_NE(err, nullptr);
+  std::array<char, 128> buf;
+  auto const [ptr, ec] =
+      FormatError<Service>(buf.data(), buf.data() + buf.size(), *err);
+  ASSERT_EQ(ec, std::errc{});
+  EXPECT_EQ(std::string_view(buf.data(), ptr),
+            "invalid value for --cache.pool.size: \"many\" (argument 2)");
+}
+
+// Groups are worked out at compile time, and parse at compile time too
+constexpr auto compiled =
+    ParseArgs<Service>(std::array{"filename", "--cache.pool.size", "16"});
+static_assert(std::get<Service>(compiled).cache.pool.size == 16);
+static_assert(std::get<Service>(compiled).cache.pool.timeout == 10);
@@ -0,0 +1,91 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <variant>
+
+// Keeps everything it is told about the last parse
+struct Recorder {
+  static inline std::vector<TraceEvent> events;
+  static inline std::vector<std::string> args;
+  static inline ParseStats stats;
+  static inline size_t fake_allocations = 0;
+
+  static void on_event(TraceEvent const &event) {
+    events.push_back(event);
+    args.push_back(event.arg != nullptr ? event.arg : "<null>");
+  }
+  static void on_stats(ParseStats const &s) { stats = s; }
+  // Stands in for a real allocation counter, each call "allocates" once
+  static size_t allocations() { return fake_allocations += 1; }
+
+  static void reset() {
+    events.clear();
+    args.clear();
+    stats = {};
+  }
+};
+
+struct Traced {
+  int a;
+  int b;
+  int pos;
+  Options __pos{.positional = true};
+};
+
+template <> struct MetaInfo<Traced> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  using instrumentation = Recorder;
+};
+
+TEST(Instrumentation, Events) {
+  Recorder::reset();
+  std::array args{"filename", "3", "--a", "1", "--b=2", "--extra"};
+  auto v = ParseArgs<Traced>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+
+  using Kind = TraceEvent::Kind;
+  std::vector<Kind> kinds;
+  std::vector<std::string_view> members;
+  for (auto const &event : Recorder::events) {
+    kinds.push_back(event.kind);
+    members.push_back(event.member);
+  }
+  EXPECT_EQ(kinds, (std::vector{Kind::Token, Kind::MemberParse, Kind::Token,
+                                Kind::MemberParse, Kind::Token,
+                                Kind::MemberParse, Kind::Token}));
+  // Tokens that are not flags (or are unknown flags) have no member
+  EXPECT_EQ(members, (std::vector<std::string_view>{"", "pos", "a", "a", "b",
+                                                    "b", ""}));
+  EXPECT_EQ(Recorder::args,
+            (std::vector<std::string>{"3", "3", "--a", "1", "--b=2", "2",
+                                      "--extra"}));
+  for (auto const &event : Recorder::events) {
+    EXPECT_TRUE(event.ok);
+  }
+
+  auto const &stats = Recorder::stats;
+  EXPECT_EQ(stats.tokens, 4);
+  EXPECT_EQ(stats.flag_hits, 2);
+  EXPECT_EQ(stats.member_parses, 3);
+  EXPECT_LE(stats.parse_time, stats.total_time);
+  EXPECT_EQ(stats.allocations, 1);
+}
+
+TEST(Instrumentation, Errors) {
+  // Stats are reported for parses that fail too
+  Recorder::reset();
+  std::array args{"filename", "--a", "x"};
+  auto v = ParseArgs<Traced>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+  EXPECT_EQ(Recorder::stats.tokens, 1);
+  EXPECT_EQ(Recorder::stats.member_parses, 1);
+  ASSERT_EQ(Recorder::events.size(), 2);
+  EXPECT_FALSE(Recorder::events.back().ok);
+}
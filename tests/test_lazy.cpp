@@ -0,0 +1,85 @@
+#include "clapp/clapp.hpp"
+#include "clapp/lazy.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <variant>
+
+// A type that counts how often it is parsed, and can be validated cheaply
+struct Hosts {
+  std::string_view list;
+  static inline int parses = 0;
+};
+
+template <> struct ArgParse<Hosts> {
+  static bool Validate(const char *arg) { return arg[0] != '\0'; }
+  static ArgParseReturnT<Hosts> Parse(auto &begin, auto const end) {
+    if (begin == end) {
+      return ParseError{};
+    }
+    Hosts::parses++;
+    std::string_view const list(*begin);
+    if (list.find(',') == std::string_view::npos) {
+      return ParseError{};
+    }
+    begin++;
+    return Hosts{list};
+  }
+};
+
+struct Deferred {
+  Lazy<Hosts> hosts;
+  Lazy<int> count{5};
+};
+
+TEST(Lazy, ParsedOnFirstRead) {
+  Hosts::parses = 0;
+  std::array args{"filename", "--hosts", "a,b", "--count=3"};
+  auto v = ParseArgs<Deferred>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &d = std::get<Deferred>(v);
+  EXPECT_EQ(Hosts::parses, 0);
+  ASSERT_TRUE(d.hosts.has_value());
+  EXPECT_EQ(d.hosts->list, "a,b");
+  EXPECT_EQ((*d.hosts).list, "a,b");
+  EXPECT_EQ(Hosts::parses, 1);
+  EXPECT_EQ(*d.count, 3);
+  EXPECT_EQ(Hosts::parses, 1);
+}
+
+TEST(Lazy, Default) {
+  std::array args{"filename"};
+  auto v = ParseArgs<Deferred>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(*std::get<Deferred>(v).count, 5);
+  EXPECT_EQ(std::get<Deferred>(v).count.source(), nullptr);
+}
+
+TEST(Lazy, Errors) {
+  // Errors that Validate catches are reported by the parse
+  std::array empty{"filename", "--hosts", ""};
+  auto v = ParseArgs<Deferred>(empty.size(), empty.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+
+  // Everything else is reported when the member is read
+  std::array bad{"filename", "--hosts", "a", "--count", "x"};
+  v = ParseArgs<Deferred>(bad.size(), bad.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &d = std::get<Deferred>(v);
+  EXPECT_TRUE(std::holds_alternative<ParseError>(d.hosts.get()));
+  EXPECT_FALSE(d.count.has_value());
+  EXPECT_STREQ(d.count.source(), "x");
+
+  // They still say what was wrong
+  auto const &err = std::get<ParseError>(d.count.get());
+  EXPECT_EQ(err.code, ErrorCode::InvalidValue);
+  EXPECT_EQ(err.value, d.count.source());
+  std::array<char, 64> buf;
+  auto const [ptr, ec] =
+      FormatError<Deferred>(buf.data(), buf.data() + buf.size(), err);
+  EXPECT_EQ(ec, std::errc{});
+  EXPECT_EQ(std::string(buf.data(), ptr), "invalid value: \"x\"");
+}
@@ -0,0 +1,121 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+struct Request {
+  std::pmr::string name;
+  std::pmr::vector<int> ports;
+  std::pmr::vector<std::pmr::string> tags;
+  int retries;
+  std::pmr::string path;
+  Options __path{.positional = true};
+};
+
+// A monotonic arena that counts what is allocated from it
+class Arena : public std::pmr::memory_resource {
+public:
+  size_t allocations = 0;
+
+private:
+  std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource upstream{
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+  void *do_allocate(size_t bytes, size_t align) override {
+    allocations++;
+    return upstream.allocate(bytes, align);
+  }
+  void do_deallocate(void *, size_t, size_t) override {}
+  bool do_is_equal(memory_resource const &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+// Makes any allocation from the default resource throw for as long as it is in
+// scope
+struct NoDefaultResource {
+  std::pmr::memory_resource *previous =
+      std::pmr::set_default_resource(std::pmr::null_memory_resource());
+  ~NoDefaultResource() { std::pmr::set_default_resource(previous); }
+};
+
+TEST(Pmr, AllFromArena) {
+  Arena arena;
+  // Long enough that none of the strings fit in a small string buffer
+  std::array args{"filename",
+                  "--name",
+                  "a name that does not fit inline",
+                  "--ports",
+                  "80",
+                  "443",
+                  "--tags",
+                  "first",
+                  "a tag that does not fit inline",
+                  "--retries",
+                  "3",
+                  "--",
+                  "/a/path/that/does/not/fit/inline"};
+  auto v = [&] {
+    NoDefaultResource const guard;
+    return ParseArgs<Request>(&arena, args.size(), args.data());
+  }();
+  ASSERT_EQ(v.index(), 0);
+  auto const &req = std::get<Request>(v);
+  EXPECT_EQ(req.name, args[2]);
+  EXPECT_EQ(req.ports, (std::pmr::vector<int>{80, 443}));
+  ASSERT_EQ(req.tags.size(), 2);
+  EXPECT_EQ(req.tags[1], args[8]);
+  EXPECT_EQ(req.retries, 3);
+  EXPECT_EQ(req.path, args[12]);
+  EXPECT_EQ(req.name.get_allocator().resource(), &arena);
+  EXPECT_EQ(req.ports.get_allocator().resource(), &arena);
+  EXPECT_EQ(req.tags[1].get_allocator().resource(), &arena);
+  EXPECT_EQ(req.path.get_allocator().resource(), &arena);
+  EXPECT_GT(arena.allocations, 0);
+}
+
+TEST(Pmr, ScopeEnds) {
+  Arena arena;
+  std::array args{"filename", "/path"};
+  auto v = ParseArgs<Request>(&arena, args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(ParseResource(), std::pmr::get_default_resource());
+}
+
+TEST(Pmr, Parser) {
+  Arena arena;
+  Parser<Request> const parser;
+  std::array args{"filename", "--tags", "a", "b", "--retries", "1", "/path"};
+  auto v = [&] {
+    NoDefaultResource const guard;
+    return parser.parse(&arena, args.size(), args.data());
+  }();
+  ASSERT_EQ(v.index(), 0);
+  auto const &req = std::get<Request>(v);
+  EXPECT_EQ(req.tags.size(), 2);
+  EXPECT_EQ(req.tags.get_allocator().resource(), &arena);
+  EXPECT_EQ(req.retries, 1);
+}
+
+TEST(Pmr, Lists) {
+  // Lists end at the next flag, and negative numbers are values
+  std::array args{"filename", "--ports", "-1", "2", "--retries", "1", "/path"};
+  auto v = ParseArgs<Request>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Request>(v).ports, (std::pmr::vector<int>{-1, 2}));
+
+  std::array empty{"filename", "--ports", "--retries", "1", "/path"};
+  auto e = ParseArgs<Request>(empty.size(), empty.data());
+  ASSERT_TRUE(std::holds_alternative<ParseError>(e));
+  EXPECT_EQ(std::get<ParseError>(e).code, ErrorCode::MissingValue);
+
+  std::array bad{"filename", "--ports", "1", "x", "/path"};
+  auto b = ParseArgs<Request>(bad.size(), bad.data());
+  ASSERT_TRUE(std::holds_alternative<ParseError>(b));
+  EXPECT_EQ(std::get<ParseError>(b).code, ErrorCode::InvalidValue);
+}
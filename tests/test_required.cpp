@@ -0,0 +1,146 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include "temp_file.hpp"
+#include <array>
+#include <string>
+#include <string_view>
+
+#include <stdlib.h>
+
+struct Deploy {
+  int port;
+  std::string_view host;
+  int retries;
+  std::string_view target;
+  Options __port{.required = true};
+  Options __host{.required = true};
+  Options __retries{.disallow_multiflag = true};
+  Options __target{.positional = true};
+};
+
+template <> struct MetaInfo<Deploy> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static std::string_view env_prefix = "DEPLOY_";
+};
+
+// The message FormatError builds for err
+template <class T> std::string Message(ErrorInfo const &err) {
+  std::array<char, 256> buf;
+  auto const [ptr, ec] =
+      FormatError<T>(buf.data(), buf.data() + buf.size(), err);
+  EXPECT_EQ(ec, std::errc{});
+  return std::string(buf.data(), ptr);
+}
+
+TEST(Required, AllGiven) {
+  std::array args{"filename", "--port", "80", "prod", "--host", "example.com",
+                  "--retries", "3"};
+  auto v = ParseArgs<Deploy>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &deploy = std::get<Deploy>(v);
+  EXPECT_EQ(deploy.port, 80);
+  EXPECT_EQ(deploy.host, "example.com");
+  EXPECT_EQ(deploy.retries, 3);
+  EXPECT_EQ(deploy.target, "prod");
+}
+
+TEST(Required, Missing) {
+  std::array args{"filename", "prod", "--host", "example.com"};
+  auto v = ParseArgs<Deploy>(args.size(), args.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(v));
+  auto const &err = std::get<UsageError>(v);
+  EXPECT_EQ(err.code, ErrorCode::MissingRequired);
+  EXPECT_EQ(err.member, 0);
+  EXPECT_TRUE(err.missing.test(0));
+  EXPECT_EQ(err.missing_count, 1u);
+  EXPECT_EQ(Message<Deploy>(err), "missing required for --port");
+}
+
+TEST(Required, AllMissing) {
+  std::array args{"filename", "prod"};
+  auto v = ParseArgs<Deploy>(args.size(), args.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(v));
+  auto const &err = std::get<UsageError>(v);
+  EXPECT_TRUE(err.missing.test(0));
+  EXPECT_TRUE(err.missing.test(1));
+  EXPECT_EQ(err.missing_count, 2u);
+  EXPECT_EQ(Message<Deploy>(err), "missing required for --port, --host");
+}
+
+struct Wide {
+  int m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16,
+      m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31,
+      m32, m33, m34, m35, m36, m37, m38, m39, m40, m41, m42, m43, m44, m45, m46,
+      m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59, m60, m61,
+      m62, m63, m64, m65, m66, m67, m68, m69;
+  Options __m1{.required = true};
+  Options __m69{.required = true};
+};
+
+TEST(Required, PastFirstWord) {
+  // Members past the first 64 are reported too
+  std::array args{"filename"};
+  auto v = ParseArgs<Wide>(args.size(), args.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(v));
+  auto const &err = std::get<UsageError>(v);
+  EXPECT_EQ(err.member, 1);
+  EXPECT_TRUE(err.missing.test(1));
+  EXPECT_TRUE(err.missing.test(69));
+  EXPECT_EQ(err.missing_count, 2u);
+  EXPECT_EQ(Message<Wide>(err), "missing required for --m1, --m69");
+
+  std::array given{"filename", "--m1", "1"};
+  v = ParseArgs<Wide>(given.size(), given.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(v));
+  EXPECT_EQ(std::get<UsageError>(v).member, 69);
+  EXPECT_EQ(Message<Wide>(std::get<UsageError>(v)),
+            "missing required for --m69");
+}
+
+TEST(Required, FromEnvironment) {
+  setenv("DEPLOY_HOST", "example.com", 1);
+  std::array args{"filename", "--port=80", "prod"};
+  auto v = ParseArgs<Deploy>(args.size(), args.data());
+  unsetenv("DEPLOY_HOST");
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Deploy>(v).host, "example.com");
+}
+
+TEST(Required, FromConfig) {
+  TempFile file("port = 80\n");
+
+  std::array args{"filename", "prod", "--host", "example.com"};
+  auto v =
+      ParseArgsWithConfig<Deploy>(file.path.c_str(), args.size(), args.data());
+  EXPECT_EQ(v.index(), 0);
+
+  // The config file alone does not give host
+  auto c = ParseConfig<Deploy>(file.path.c_str());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(c));
+  EXPECT_EQ(std::get<UsageError>(c).member, 1);
+}
+
+TEST(Required, DuplicateFlag) {
+  std::array args{"filename", "--port", "80", "--host", "example.com",
+                  "--retries", "3", "prod", "--retries=4"};
+  auto v = ParseArgs<Deploy>(args.size(), args.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(v));
+  auto const &err = std::get<UsageError>(v);
+  EXPECT_EQ(err.code, ErrorCode::DuplicateFlag);
+  EXPECT_EQ(err.arg_index, 8);
+  EXPECT_EQ(err.member, 2);
+  EXPECT_EQ(Message<Deploy>(err), "flag given more than once for --retries: "
+                                  "\"--retries=4\" (argument 8)");
+}
+
+TEST(Required, MultiflagAllowed) {
+  // Without disallow_multiflag, the last one wins
+  std::array args{"filename", "--port", "80", "--host", "a", "--host", "b",
+                  "prod"};
+  auto v = ParseArgs<Deploy>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Deploy>(v).host, "b");
+}
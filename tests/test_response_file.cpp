@@ -0,0 +1,89 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include "temp_file.hpp"
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include <variant>
+
+struct Job {
+  int count;
+  std::string_view name;
+  std::string_view input;
+  std::string_view output;
+  Options __input{.positional = true};
+  Options __output{.positional = true};
+};
+
+template <> struct MetaInfo<Job> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static bool response_files = true;
+};
+
+TEST(ResponseFile, Whitespace) {
+  TempFile file("--count 3\n\t--name 'a name with spaces'  \"in\\\"put\"\n");
+  std::array args{"filename", file.arg.c_str(), "out"};
+  auto v = ParseArgs<Job>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &job = std::get<Job>(v);
+  EXPECT_EQ(job.count, 3);
+  EXPECT_EQ(job.name, "a name with spaces");
+  EXPECT_EQ(job.input, "in\"put");
+  EXPECT_EQ(job.output, "out");
+}
+
+TEST(ResponseFile, NulDelimited) {
+  using namespace std::string_literals;
+  TempFile file("--name\0two words\0in\0out"s);
+  std::array args{"filename", "--count", "1", file.arg.c_str()};
+  auto v = ParseArgs<Job>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &job = std::get<Job>(v);
+  EXPECT_EQ(job.count, 1);
+  EXPECT_EQ(job.name, "two words");
+  EXPECT_EQ(job.input, "in");
+  EXPECT_EQ(job.output, "out");
+}
+
+TEST(ResponseFile, Nested) {
+  TempFile inner("--count 7");
+  TempFile outer(inner.arg + " in out");
+  std::array args{"filename", outer.arg.c_str()};
+  MappedFiles files;
+  auto v = Parser<Job>{}.parse(args.size(), args.data(), files);
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Job>(v).count, 7);
+  EXPECT_EQ(std::get<Job>(v).input, "in");
+  EXPECT_EQ(files.files.size(), 2);
+}
+
+TEST(ResponseFile, Missing) {
+  std::array args{"filename", "@/this/file/does/not/exist"};
+  auto v = ParseArgs<Job>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+}
+
+TEST(ResponseFile, FlagValueInFile) {
+  // A flag's value has to be in the same file (or argv) as the flag
+  TempFile file("3 in out");
+  std::array args{"filename", "--count", file.arg.c_str()};
+  auto v = ParseArgs<Job>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+}
+
+struct NoResponseFiles {
+  std::string_view input;
+  Options __input{.positional = true};
+};
+
+TEST(ResponseFile, DisabledByDefault) {
+  std::array args{"filename", "@not-a-file"};
+  auto v = ParseArgs<NoResponseFiles>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<NoResponseFiles>(v).input, "@not-a-file");
+}
@@ -2,8 +2,13 @@
 #include "clapp/types.hpp"
 #include "gtest/gtest.h"
 #include <array>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
 #include <variant>
 
 struct SuperSimple {
@@ -53,6 +58,24 @@ TEST(Simple, Rename) {
   EXPECT_EQ(std::get<Rename>(v).flag, 10);
 }
 
+struct NonAscii {
+  int a;
+  int ete;
+  int z;
+  Options __ete{.name = "--\xc3\xa9t\xc3\xa9"};
+};
+
+TEST(Simple, NonAsciiFlag) {
+  // Bytes past 0x7f sort after every ASCII flag
+  std::array args{"filename", "--a", "1", "--\xc3\xa9t\xc3\xa9",
+                  "2",        "--z", "3"};
+  auto v = ParseArgs<NonAscii>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<NonAscii>(v).a, 1);
+  EXPECT_EQ(std::get<NonAscii>(v).ete, 2);
+  EXPECT_EQ(std::get<NonAscii>(v).z, 3);
+}
+
 struct Positional {
   int positional;
   Options __positional{.positional = true};
@@ -82,7 +105,191 @@ TEST(Simple, Help) {
   testing::internal::CaptureStdout();
   ParseArgs<Positional>(args.size(), args.data());
   auto out = testing::internal::GetCapturedStdout();
-  EXPECT_EQ(out, "Usage: filename <positional>\n");
+  EXPECT_EQ(out, "Usage: filename <positional>\n"
+            "\n"
+            "Arguments:\n"
+            "  <positional>  int\n"
+            "\n"
+            "Options:\n"
+            "  --help, --h   Show this help\n");
+}
+
+TEST(Simple, HelpNotLiteral) {
+  // Help args are matched by value, not by pointer
+  std::string help = "--help";
+  std::array args{"filename", help.c_str()};
+  testing::internal::CaptureStdout();
+  auto v = ParseArgs<Positional>(args.size(), args.data());
+  auto out = testing::internal::GetCapturedStdout();
+  EXPECT_TRUE(std::holds_alternative<UsageError>(v));
+  EXPECT_TRUE(out.starts_with("Usage: filename <positional>\n"));
+}
+
+struct Mixed {
+  int a;
+  int b;
+  int pos;
+  int c;
+  Options __pos{.positional = true};
+  Options __c{.name = "-c"};
+};
+
+TEST(Simple, MixedFlagsAndPositional) {
+  std::array args{"filename", "-c", "3", "--b", "2", "4", "--a", "1"};
+  auto v = ParseArgs<Mixed>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &m = std::get<Mixed>(v);
+  EXPECT_EQ(m.a, 1);
+  EXPECT_EQ(m.b, 2);
+  EXPECT_EQ(m.c, 3);
+  EXPECT_EQ(m.pos, 4);
+}
+
+TEST(Simple, HelpFlags) {
+  std::array args{"filename", "--help"};
+  testing::internal::CaptureStdout();
+  auto v = ParseArgs<Mixed>(args.size(), args.data(), 1, 0, 0, 3);
+  auto out = testing::internal::GetCapturedStdout();
+  EXPECT_TRUE(std::holds_alternative<UsageError>(v));
+  EXPECT_EQ(out, "Usage: filename [options] <pos>\n"
+                 "\n"
+                 "Arguments:\n"
+                 "  <pos>        int\n"
+                 "\n"
+                 "Options:\n"
+                 "  --a <int>    (default: 1)\n"
+                 "  --b <int>    (default: 0)\n"
+                 "  -c <int>     (default: 3)\n"
+                 "  --help, --h  Show this help\n");
+}
+
+TEST(Simple, LongOutput) {
+  // Output longer than the inline buffer is still held until one flush
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  std::string const line(100, 'x');
+  {
+    detail::OutputBuffer out(fds[1]);
+    for (int i = 0; i < 200; i++) {
+      out.append(line);
+      out.newline();
+    }
+    ASSERT_EQ(fcntl(fds[0], F_SETFL, O_NONBLOCK), 0);
+    char c;
+    EXPECT_EQ(read(fds[0], &c, 1), -1);
+  }
+  close(fds[1]);
+  std::string written;
+  std::array<char, 4096> buf;
+  ssize_t n;
+  while ((n = read(fds[0], buf.data(), buf.size())) > 0) {
+    written.append(buf.data(), static_cast<size_t>(n));
+  }
+  close(fds[0]);
+  EXPECT_EQ(written.size(), 200u * 101u);
+}
+
+TEST(Simple, InlineValue) {
+  std::array args{"filename", "--a=1", "-c=-3", "--b", "2", "4"};
+  auto v = ParseArgs<Mixed>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &m = std::get<Mixed>(v);
+  EXPECT_EQ(m.a, 1);
+  EXPECT_EQ(m.b, 2);
+  EXPECT_EQ(m.c, -3);
+  EXPECT_EQ(m.pos, 4);
+}
+
+TEST(Simple, BadInlineValue) {
+  for (auto const *arg : {"--a=", "--a=x", "--a=1=2"}) {
+    std::array args{"filename", arg, "4"};
+    auto v = ParseArgs<Mixed>(args.size(), args.data());
+    EXPECT_TRUE(std::holds_alternative<ParseError>(v)) << arg;
+  }
+}
+
+TEST(Simple, EndOfOptions) {
+  // After --, args that look like flags are positionals
+  std::array args{"filename", "--a", "1", "--", "-5"};
+  auto v = ParseArgs<Mixed>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Mixed>(v).a, 1);
+  EXPECT_EQ(std::get<Mixed>(v).pos, -5);
+
+  std::array flag_args{"filename", "--", "--a"};
+  v = ParseArgs<Mixed>(flag_args.size(), flag_args.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+}
+
+TEST(Simple, ReusableParser) {
+  Parser<Mixed> const parser{};
+  // The same parser can be used from many threads at once
+  std::array<std::string, 4> values{"0", "1", "2", "3"};
+  std::array<bool, values.size()> ok{};
+  std::array<std::thread, values.size()> threads;
+  for (size_t i = 0; i < threads.size(); i++) {
+    threads[i] = std::thread([&, i] {
+      std::array args{"filename", "--a", values[i].c_str(), "5"};
+      ok[i] = true;
+      for (int n = 0; n < 1000; n++) {
+        auto v = parser.parse(args.size(), args.data());
+        ok[i] &= v.index() == 0 &&
+                 std::get<Mixed>(v).a == static_cast<int>(i) &&
+                 std::get<Mixed>(v).pos == 5;
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (auto b : ok) {
+    EXPECT_TRUE(b);
+  }
+}
+
+TEST(Simple, Batch) {
+  // Enough command lines to be split across threads, with a bad one mixed in
+  std::vector<std::string> values;
+  for (int i = 0; i < 1000; i++) {
+    values.push_back(i == 500 ? "not an int" : std::to_string(i));
+  }
+  std::vector<std::array<const char *, 3>> argvs;
+  for (auto const &value : values) {
+    argvs.push_back({"filename", "--flag", value.c_str()});
+  }
+  std::vector<std::span<const char *>> batch(argvs.begin(), argvs.end());
+  auto results = ParseArgsBatch<SuperSimple>(batch, 4);
+  ASSERT_EQ(results.size(), batch.size());
+  for (int i = 0; i < static_cast<int>(results.size()); i++) {
+    if (i == 500) {
+      EXPECT_TRUE(std::holds_alternative<ParseError>(results[i]));
+    } else {
+      ASSERT_EQ(results[i].index(), 0);
+      EXPECT_EQ(std::get<SuperSimple>(results[i]).flag, i);
+    }
+  }
+}
+
+struct ManyMembers {
+  int _0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,
+      _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31,
+      _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46,
+      _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61,
+      _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76,
+      _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91,
+      _92, _93, _94, _95, _96, _97, _98, _99, _100, _101, _102, _103, _104,
+      _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116,
+      _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128,
+      _129, _130, _131, _132, _133, _134, _135, _136, _137, _138, _139, _140,
+      _141, _142, _143, _144, _145, _146, _147, _148, _149;
+};
+
+TEST(Simple, ManyMembers) {
+  std::array args{"filename", "--_149", "149", "--_0", "0"};
+  auto v = ParseArgs<ManyMembers>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<ManyMembers>(v)._0, 0);
+  EXPECT_EQ(std::get<ManyMembers>(v)._149, 149);
 }
 
 struct TooManyMembers {
@@ -90,13 +297,27 @@ struct TooManyMembers {
       _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31,
       _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46,
       _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61,
-      _62, _63;
-  int last_one;
+      _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76,
+      _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91,
+      _92, _93, _94, _95, _96, _97, _98, _99, _100, _101, _102, _103, _104,
+      _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116,
+      _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128,
+      _129, _130, _131, _132, _133, _134, _135, _136, _137, _138, _139, _140,
+      _141, _142, _143, _144, _145, _146, _147, _148, _149, _150, _151, _152,
+      _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164,
+      _165, _166, _167, _168, _169, _170, _171, _172, _173, _174, _175, _176,
+      _177, _178, _179, _180, _181, _182, _183, _184, _185, _186, _187, _188,
+      _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200,
+      _201, _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212,
+      _213, _214, _215, _216, _217, _218, _219, _220, _221, _222, _223, _224,
+      _225, _226, _227, _228, _229, _230, _231, _232, _233, _234, _235, _236,
+      _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248,
+      _249, _250, _251, _252, _253, _254, _255, last_one;
 };
 
 /*
 error: static assertion failed due to requirement
-'UnpackableWrapperError<TooManyMembers, false, 64UL>::value': Must have fewer
+'UnpackableWrapperError<TooManyMembers, false, 256>::value': Must have fewer
 members to be unpackable!
 */
 // TEST(MisCompile, TooManyMembers) {
@@ -0,0 +1,117 @@
+#include "clapp/clapp.hpp"
+#include "clapp/sink.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+struct Copy {
+  int jobs;
+  std::string_view dest;
+  Sink<std::function<void(std::string_view)>> files;
+  Options __dest{.positional = true};
+  Options __files{.positional = true};
+};
+
+TEST(Sink, Callback) {
+  std::vector<std::string> seen;
+  std::array args{"filename", "/dest", "a", "--jobs", "4", "b", "c"};
+  auto v = ParseArgs<Copy>(args.size(), args.data(), 0, "",
+                           [&](std::string_view file) {
+                             seen.emplace_back(file);
+                           });
+  ASSERT_EQ(v.index(), 0);
+  auto const &copy = std::get<Copy>(v);
+  EXPECT_EQ(copy.jobs, 4);
+  EXPECT_EQ(copy.dest, "/dest");
+  EXPECT_EQ(copy.files.count(), 3);
+  EXPECT_EQ(seen, (std::vector<std::string>{"a", "b", "c"}));
+}
+
+TEST(Sink, Empty) {
+  // The other positionals are still required, the sink is not
+  std::array args{"filename", "/dest"};
+  auto v = ParseArgs<Copy>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Copy>(v).files.count(), 0);
+
+  std::array none{"filename"};
+  auto n = ParseArgs<Copy>(none.size(), none.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(n));
+  EXPECT_EQ(std::get<UsageError>(n).code, ErrorCode::MissingPositional);
+}
+
+struct Sum {
+  Sink<std::function<bool(int)>, int> values;
+  Options __values{.positional = true};
+};
+
+TEST(Sink, Rejected) {
+  int total = 0;
+  auto add = [&](int value) {
+    total += value;
+    return value >= 0;
+  };
+  std::array args{"filename", "1", "2", "x"};
+  auto v = ParseArgs<Sum>(args.size(), args.data(), add);
+  ASSERT_TRUE(std::holds_alternative<ParseError>(v));
+  EXPECT_EQ(std::get<ParseError>(v).code, ErrorCode::InvalidPositional);
+  EXPECT_EQ(std::get<ParseError>(v).arg_index, 3);
+  EXPECT_EQ(total, 3);
+
+  std::array negative{"filename", "1", "--", "-2", "3"};
+  auto n = ParseArgs<Sum>(negative.size(), negative.data(), add);
+  ASSERT_TRUE(std::holds_alternative<ParseError>(n));
+  EXPECT_EQ(std::get<ParseError>(n).code, ErrorCode::InvalidValue);
+  EXPECT_EQ(std::get<ParseError>(n).arg_index, 3);
+}
+
+struct TwoSinks {
+  Sink<std::function<void(std::string_view)>> sources;
+  Sink<std::function<void(std::string_view)>> targets;
+  Options __sources{.positional = true};
+  Options __targets{.positional = true};
+};
+
+TEST(Sink, OnlyOne) {
+  // There is no telling where the first sink would stop
+  std::array args{"filename", "a", "b"};
+  auto v = ParseArgs<TwoSinks>(args.size(), args.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(v));
+  EXPECT_EQ(std::get<UsageError>(v).code, ErrorCode::BadSchema);
+  EXPECT_EQ(std::get<UsageError>(v).member, 1);
+}
+
+TEST(Sink, Stream) {
+  // Every file name is handed on before the next window is read
+  std::string contents;
+  for (int i = 0; i < 1000; i++) {
+    contents += "/some/file/" + std::to_string(i);
+    contents.push_back('\0');
+  }
+  std::array<int, 2> fds;
+  ASSERT_EQ(pipe(fds.data()), 0);
+  ASSERT_EQ(write(fds[1], contents.data(), contents.size()),
+            static_cast<ssize_t>(contents.size()));
+  close(fds[1]);
+
+  size_t count = 0;
+  size_t bytes = 0;
+  std::array<char, 64> buffer;
+  auto v = ParseArgStream<Copy>(fds[0], buffer, 0, "",
+                                [&](std::string_view file) {
+                                  count++;
+                                  bytes += file.size();
+                                });
+  close(fds[0]);
+  ASSERT_EQ(v.index(), 0);
+  // The first name is the dest
+  EXPECT_EQ(count, 999);
+  EXPECT_EQ(bytes + std::string_view("/some/file/0").size() + 1000,
+            contents.size());
+}
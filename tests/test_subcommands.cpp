@@ -0,0 +1,96 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <string_view>
+
+#include <variant>
+
+struct BuildCmd {
+  int jobs;
+  std::string_view target;
+  Options __target{.positional = true};
+};
+
+template <> struct MetaInfo<BuildCmd> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = true;
+  constexpr static std::string_view command_name = "build";
+};
+
+struct RunCmd {
+  int times;
+};
+
+template <> struct MetaInfo<RunCmd> {
+  constexpr static std::string_view OptionsPrefix = "__";
+  constexpr static std::array help_args{"--help", "--h"};
+  constexpr static bool extra_args_ok = false;
+  constexpr static std::string_view command_name = "run";
+};
+
+using Commands = std::variant<BuildCmd, RunCmd>;
+
+TEST(Subcommands, Select) {
+  std::array build{"filename", "build", "--jobs", "8", "all"};
+  auto v = ParseArgs<Commands>(build.size(), build.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &cmd = std::get<Commands>(v);
+  ASSERT_TRUE(std::holds_alternative<BuildCmd>(cmd));
+  EXPECT_EQ(std::get<BuildCmd>(cmd).jobs, 8);
+  EXPECT_EQ(std::get<BuildCmd>(cmd).target, "all");
+
+  std::array run{"filename", "run", "--times", "3"};
+  v = ParseArgs<Commands>(run.size(), run.data());
+  ASSERT_EQ(v.index(), 0);
+  ASSERT_TRUE(std::holds_alternative<RunCmd>(std::get<Commands>(v)));
+  EXPECT_EQ(std::get<RunCmd>(std::get<Commands>(v)).times, 3);
+}
+
+TEST(Subcommands, Errors) {
+  // With no command at all, we list the commands
+  std::array none{"filename"};
+  testing::internal::CaptureStdout();
+  auto v = ParseArgs<Commands>(none.size(), none.data());
+  EXPECT_EQ(testing::internal::GetCapturedStdout(),
+            "Usage: filename <command>\nCommands:\n  build\n  run\n");
+  EXPECT_TRUE(std::holds_alternative<UsageError>(v));
+
+  std::array unknown{"filename", "test"};
+  v = ParseArgs<Commands>(unknown.size(), unknown.data());
+  EXPECT_TRUE(std::holds_alternative<UnknownArgError>(v));
+
+  // Errors from the command itself come through as they are
+  std::array bad{"filename", "run", "--times", "x"};
+  v = ParseArgs<Commands>(bad.size(), bad.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+
+  std::array extra{"filename", "run", "--jobs", "1"};
+  v = ParseArgs<Commands>(extra.size(), extra.data());
+  EXPECT_TRUE(std::holds_alternative<UnknownArgError>(v));
+
+  std::array missing{"filename", "build"};
+  v = ParseArgs<Commands>(missing.size(), missing.data());
+  EXPECT_TRUE(std::holds_alternative<UsageError>(v));
+}
+
+TEST(Subcommands, Help) {
+  testing::internal::CaptureStdout();
+  std::array args{"filename", "--help"};
+  auto v = ParseArgs<Commands>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<UsageError>(v));
+  EXPECT_EQ(testing::internal::GetCapturedStdout(),
+            "Usage: filename <command>\nCommands:\n  build\n  run\n");
+}
+
+TEST(Subcommands, CommandHelp) {
+  // The usage line names the program as well as the command
+  testing::internal::CaptureStdout();
+  std::array args{"filename", "build", "--help"};
+  auto v = ParseArgs<Commands>(args.size(), args.data());
+  ASSERT_TRUE(std::holds_alternative<UsageError>(v));
+  EXPECT_EQ(std::get<UsageError>(v).arg_index, 2);
+  EXPECT_TRUE(testing::internal::GetCapturedStdout().starts_with(
+      "Usage: filename build [options] <target>\n"));
+}
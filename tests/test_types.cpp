@@ -0,0 +1,177 @@
+#include "clapp/clapp.hpp"
+#include "clapp/types.hpp"
+#include "gtest/gtest.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <variant>
+
+// Parse a single value of T through its ArgParse, as if it were the value of a
+// flag
+template <class T> ArgParseReturnT<T> ParseOne(const char *arg) {
+  std::array args{arg};
+  auto begin = args.data();
+  return ArgParse<T>::Parse(begin, args.data() + args.size());
+}
+
+template <class T> void ExpectValue(const char *arg, T expected) {
+  auto v = ParseOne<T>(arg);
+  ASSERT_EQ(v.index(), 0) << arg;
+  EXPECT_EQ(std::get<T>(v), expected) << arg;
+}
+
+template <class T> void ExpectError(const char *arg) {
+  EXPECT_TRUE(std::holds_alternative<ParseError>(ParseOne<T>(arg))) << arg;
+}
+
+TEST(Types, Integers) {
+  ExpectValue<int>("0", 0);
+  ExpectValue<int>("42", 42);
+  ExpectValue<int>("-42", -42);
+  ExpectValue<int>("+42", 42);
+  ExpectValue<long long>("9223372036854775807",
+                         std::numeric_limits<long long>::max());
+  ExpectValue<long long>("-9223372036854775808",
+                         std::numeric_limits<long long>::min());
+  ExpectValue<unsigned long long>("18446744073709551615",
+                                  std::numeric_limits<unsigned long long>::max());
+  ExpectError<int>("");
+  ExpectError<int>("4x");
+  ExpectError<int>(" 4");
+  ExpectError<int>("--4");
+}
+
+TEST(Types, IntegerRanges) {
+  ExpectValue<std::int8_t>("127", 127);
+  ExpectValue<std::int8_t>("-128", -128);
+  ExpectError<std::int8_t>("128");
+  ExpectError<std::int8_t>("-129");
+  ExpectValue<std::uint8_t>("255", 255);
+  ExpectError<std::uint8_t>("256");
+  ExpectError<unsigned>("-1");
+  ExpectValue<short>("-32768", -32768);
+  ExpectError<short>("32768");
+  ExpectError<int>("99999999999999999999");
+}
+
+TEST(Types, IntegerPrefixes) {
+  ExpectValue<int>("0x1f", 31);
+  ExpectValue<int>("0X1F", 31);
+  ExpectValue<int>("-0x10", -16);
+  ExpectValue<int>("0o17", 15);
+  ExpectValue<int>("017", 15);
+  ExpectValue<int>("0b101", 5);
+  ExpectValue<std::uint8_t>("0xff", 255);
+  ExpectError<std::uint8_t>("0x100");
+  ExpectError<int>("0x");
+  ExpectError<int>("0b2");
+  ExpectError<int>("09");
+}
+
+TEST(Types, DigitSeparators) {
+  ExpectValue<int>("1'000'000", 1000000);
+  ExpectValue<int>("1_000", 1000);
+  ExpectValue<unsigned>("0xffff_ffff", 0xffffffff);
+  ExpectError<int>("'1");
+  ExpectError<int>("1'");
+  ExpectError<int>("1''0");
+  // Only between digits, not next to a sign or prefix
+  ExpectError<int>("-_1");
+  ExpectError<int>("+'1");
+  ExpectError<int>("0_x1");
+  ExpectError<int>("0x_1");
+  ExpectError<int>("0_7");
+  ExpectError<int>("0b1_2");
+  ExpectError<double>("-_1.5");
+  ExpectError<double>("1_.5");
+  ExpectError<double>("1._5");
+  ExpectError<double>("1e_5");
+  ExpectError<double>("0x_1p4");
+}
+
+TEST(Types, Floating) {
+  ExpectValue<double>("1.5", 1.5);
+  ExpectValue<double>("-2.25e2", -225.0);
+  ExpectValue<double>("+3", 3.0);
+  ExpectValue<float>("0.5", 0.5f);
+  ExpectValue<double>("0x1p4", 16.0);
+  ExpectValue<double>("1'000.5", 1000.5);
+  ExpectValue<long double>("2.5", 2.5L);
+  ExpectError<double>("");
+  ExpectError<double>("1.5x");
+  ExpectError<double>("abc");
+  ExpectError<float>("1e999");
+}
+
+struct Numbers {
+  unsigned count;
+  double ratio;
+  long long big;
+};
+
+TEST(Types, Members) {
+  std::array args{"filename", "--count",  "0x10", "--ratio",
+                  "0.25",     "--big",    "-1'000'000'000'000"};
+  auto v = ParseArgs<Numbers>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  EXPECT_EQ(std::get<Numbers>(v).count, 16u);
+  EXPECT_EQ(std::get<Numbers>(v).ratio, 0.25);
+  EXPECT_EQ(std::get<Numbers>(v).big, -1000000000000LL);
+}
+
+struct Strings {
+  std::string_view view;
+  const char *pointer;
+  std::string owned;
+  std::string_view path;
+  Options __path{.positional = true};
+};
+
+TEST(Types, Strings) {
+  std::array args{"filename", "--view", "a view", "--pointer", "a pointer",
+                  "--owned",  "a copy", "/some/path"};
+  auto v = ParseArgs<Strings>(args.size(), args.data());
+  ASSERT_EQ(v.index(), 0);
+  auto const &s = std::get<Strings>(v);
+  EXPECT_EQ(s.view, "a view");
+  EXPECT_EQ(s.pointer, std::string_view("a pointer"));
+  EXPECT_EQ(s.owned, "a copy");
+  EXPECT_EQ(s.path, "/some/path");
+  // Views point straight into argv rather than at a copy
+  EXPECT_EQ(s.view.data(), args[2]);
+  EXPECT_EQ(s.pointer, args[4]);
+  EXPECT_EQ(s.path.data(), args[7]);
+}
+
+TEST(Types, MissingString) {
+  std::array args{"filename", "--view"};
+  auto v = ParseArgs<Strings>(args.size(), args.data());
+  EXPECT_TRUE(std::holds_alternative<ParseError>(v));
+}
+
+// Format a value of T through its ArgParse, or return nothing if it fails
+template <class T> std::string FormatOne(T const &value) {
+  std::array<char, 64> buf;
+  auto const [ptr, ec] =
+      ArgParse<T>::Format(buf.data(), buf.data() + buf.size(), value);
+  if (ec != std::errc{}) {
+    return "<none>";
+  }
+  return std::string(buf.data(), ptr);
+}
+
+TEST(Types, Format) {
+  EXPECT_EQ(FormatOne<int>(-42), "-42");
+  EXPECT_EQ(FormatOne<std::uint8_t>(255), "255");
+  EXPECT_EQ(FormatOne<double>(0.5), "0.5");
+  EXPECT_EQ(FormatOne<std::string_view>("a b"), "\"a b\"");
+  EXPECT_EQ(FormatOne<const char *>("path"), "\"path\"");
+  EXPECT_EQ(FormatOne<std::string>("owned"), "\"owned\"");
+  // Nothing worth printing
+  EXPECT_EQ(FormatOne<std::string_view>(""), "<none>");
+  EXPECT_EQ(FormatOne<const char *>(nullptr), "<none>");
+  EXPECT_EQ(FormatOne<std::string_view>(std::string(100, 'x')), "<none>");
+}